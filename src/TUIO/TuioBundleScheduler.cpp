@@ -0,0 +1,97 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioBundleScheduler.h"
+#include "TuioTime.h"
+#include <algorithm>
+#include <string.h>
+
+using namespace TUIO;
+
+// the time tag of an immediate bundle
+#define TUIO_TIMETAG_IMMEDIATE 1ULL
+
+TuioBundleScheduler::TuioBundleScheduler(int ms)
+: released(-1)
+, sequence(0)
+, horizon ((long long)ms*1000000LL)
+{
+	heap.reserve(TUIO_SCHEDULE_BUNDLES);
+	freeBundles.reserve(TUIO_SCHEDULE_BUNDLES);
+	for (int i=TUIO_SCHEDULE_BUNDLES-1;i>=0;i--) freeBundles.push_back(i);
+}
+
+bool TuioBundleScheduler::schedule(const char *data, int size, const IpEndpointName &endpoint, TuioSource *source) {
+	// only the time tag is read here, the bundle is validated when it is processed
+	if ((size<16) || (memcmp(data,"#bundle",8)!=0)) return false;
+
+	const unsigned char *tag = (const unsigned char*)data+8;
+	unsigned long long timetag = 0;
+	for (int i=0;i<8;i++) timetag = (timetag<<8) | tag[i];
+	if (timetag==TUIO_TIMETAG_IMMEDIATE) return false;
+
+	long long now = TuioTime::getSessionTime().getTotalNanoseconds();
+	long long due = TuioTime::fromTimeTag(timetag).getTotalNanoseconds();
+	if ((due<=now) || ((due-now)>horizon) || (freeBundles.empty())) return false;
+
+	int index = freeBundles.back();
+	freeBundles.pop_back();
+	Bundle &bundle = bundles[index];
+	bundle.data.assign(data,data+size);
+	bundle.endpoint = endpoint;
+	bundle.source = source;
+
+	Entry entry;
+	entry.due = due;
+	entry.sequence = sequence++;
+	entry.bundle = index;
+	heap.push_back(entry);
+	std::push_heap(heap.begin(),heap.end(),later);
+	return true;
+}
+
+bool TuioBundleScheduler::next(const char *&data, int &size, IpEndpointName &endpoint, TuioSource *&source) {
+	if (released>=0) {
+		freeBundles.push_back(released);
+		released = -1;
+	}
+
+	if (heap.empty()) return false;
+	if (heap.front().due>TuioTime::getSessionTime().getTotalNanoseconds()) return false;
+
+	released = heap.front().bundle;
+	std::pop_heap(heap.begin(),heap.end(),later);
+	heap.pop_back();
+
+	Bundle &bundle = bundles[released];
+	data = &bundle.data[0];
+	size = (int)bundle.data.size();
+	endpoint = bundle.endpoint;
+	source = bundle.source;
+	return true;
+}
+
+void TuioBundleScheduler::clear() {
+	if (released>=0) freeBundles.push_back(released);
+	released = -1;
+	for (unsigned int i=0;i<heap.size();i++) freeBundles.push_back(heap[i].bundle);
+	heap.clear();
+}
@@ -0,0 +1,118 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOBUNDLESCHEDULER_H
+#define INCLUDED_TUIOBUNDLESCHEDULER_H
+
+#include <vector>
+#include "ip/IpEndpointName.h"
+
+#define TUIO_SCHEDULE_BUNDLES 64	// maximum number of held bundles
+#define TUIO_SCHEDULE_HORIZON 1000	// default maximum time in milliseconds a bundle is held
+#define TUIO_SCHEDULE_TICK 1		// milliseconds between the checks for due bundles
+
+namespace TUIO {
+
+	class TuioSource;
+
+	/**
+	 * The TuioBundleScheduler class holds received OSC bundles with a time tag in the future until they are due.
+	 * Immediate bundles, bundles which are already due or too far in the future and all other packets are
+	 * not held, so they can be processed at once. The held bundles are kept in a min-heap ordered by their
+	 * due time and the order they have been received in. Their data is copied into a fixed number of reused
+	 * buffers, which do not allocate any memory once they have reached the usual bundle size.
+	 *
+	 * @version 1.4
+	 */
+	class TuioBundleScheduler {
+
+	private:
+		struct Bundle {
+			std::vector<char> data;
+			IpEndpointName endpoint;
+			TuioSource *source;
+		};
+
+		struct Entry {
+			long long due;
+			unsigned long sequence;
+			int bundle;
+		};
+
+		static bool later(const Entry &a, const Entry &b) {
+			return (a.due>b.due) || ((a.due==b.due) && (a.sequence>b.sequence));
+		}
+
+		Bundle bundles[TUIO_SCHEDULE_BUNDLES];
+		std::vector<Entry> heap;
+		std::vector<int> freeBundles;
+		int released;
+		unsigned long sequence;
+		long long horizon;
+
+		TuioBundleScheduler(const TuioBundleScheduler&);
+		TuioBundleScheduler& operator=(const TuioBundleScheduler&);
+
+	public:
+		/**
+		 * This constructor creates an empty TuioBundleScheduler with the provided horizon.
+		 *
+		 * @param	ms	the maximum time in milliseconds a bundle is held
+		 */
+		TuioBundleScheduler(int ms = TUIO_SCHEDULE_HORIZON);
+
+		/**
+		 * Holds a copy of the provided packet if it is a bundle which is due within the horizon.
+		 * If all buffers are in use, the bundle is not held either.
+		 *
+		 * @param	data	the received packet
+		 * @param	size	the size of the received packet
+		 * @param	endpoint	the origin of the received packet
+		 * @param	source	the TuioSource the packet has been received for or NULL
+		 * @return	true if the bundle is held, false if the packet should be processed at once
+		 */
+		bool schedule(const char *data, int size, const IpEndpointName &endpoint, TuioSource *source);
+
+		/**
+		 * Releases the held bundle which is due first if its due time has passed.
+		 * The returned data remains valid until the next call.
+		 *
+		 * @param	data	returns the data of the released bundle
+		 * @param	size	returns the size of the released bundle
+		 * @param	endpoint	returns the origin of the released bundle
+		 * @param	source	returns the TuioSource the bundle has been received for or NULL
+		 * @return	true if a bundle has been released
+		 */
+		bool next(const char *&data, int &size, IpEndpointName &endpoint, TuioSource *&source);
+
+		/**
+		 * Drops all held bundles.
+		 */
+		void clear();
+
+		/**
+		 * Returns the number of held bundles.
+		 * @return	the number of held bundles
+		 */
+		int getPendingCount() const { return (int)heap.size(); }
+	};
+};
+#endif /* INCLUDED_TUIOBUNDLESCHEDULER_H */
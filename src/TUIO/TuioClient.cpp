@@ -20,6 +20,7 @@
  */
 
 #include "TuioClient.h"
+#include <stdio.h>
 
 using namespace TUIO;
 using namespace osc;
@@ -30,7 +31,19 @@ static void* ClientThreadFunc( void* obj )
 static DWORD WINAPI ClientThreadFunc( LPVOID obj )
 #endif
 {
-	static_cast<TuioClient*>(obj)->socket->Run();
+	TuioClient *client = static_cast<TuioClient*>(obj);
+	if (client->stream!=NULL) client->stream->Run(client);
+	else client->socket->Run();
+	return 0;
+};
+
+#ifndef WIN32
+void* TuioClient::sharedMemoryThreadFunc( void* obj )
+#else
+DWORD WINAPI TuioClient::sharedMemoryThreadFunc( LPVOID obj )
+#endif
+{
+	static_cast<TuioClient*>(obj)->runSharedMemory();
 	return 0;
 };
 
@@ -72,8 +85,19 @@ void TuioClient::unlockCursorList() {
 
 TuioClient::TuioClient(int port, bool mode3d)
 : socket      (NULL)
+, stream      (NULL)
+, cursorAliveReceived(false)
 , currentFrame(-1)
-, maxCursorID (-1)
+, objectStamp (0)
+, cursorStamp (0)
+, jitterBuffer(NULL)
+, scheduler   (NULL)
+, timerTick   (0)
+, sourceCount (0)
+, currentSource(NULL)
+, sourceMerging(false)
+, sharedMemory(NULL)
+, sharedMemoryRunning(false)
 , thread      (NULL)
 , locked      (false)
 , connected   (false)
@@ -95,8 +119,69 @@ TuioClient::TuioClient(int port, bool mode3d)
 	}	
 }
 
+TuioClient::TuioClient(const char *name, bool mode3d)
+: socket      (NULL)
+, stream      (NULL)
+, cursorAliveReceived(false)
+, currentFrame(-1)
+, objectStamp (0)
+, cursorStamp (0)
+, jitterBuffer(NULL)
+, scheduler   (NULL)
+, timerTick   (0)
+, sourceCount (0)
+, currentSource(NULL)
+, sourceMerging(false)
+, sharedMemory(NULL)
+, sharedMemoryRunning(false)
+, thread      (NULL)
+, locked      (false)
+, connected   (false)
+{
+	this->mode3d = mode3d;
+	
+	sharedMemory = TuioSharedMemory::createReader(name);
+	if (sharedMemory!=NULL) std::cout << "reading TUIO frames from shared memory " << name << std::endl;
+}
+
+TuioClient::TuioClient(const char *host, int port, bool mode3d)
+: socket      (NULL)
+, stream      (NULL)
+, cursorAliveReceived(false)
+, currentFrame(-1)
+, objectStamp (0)
+, cursorStamp (0)
+, jitterBuffer(NULL)
+, scheduler   (NULL)
+, timerTick   (0)
+, sourceCount (0)
+, currentSource(NULL)
+, sourceMerging(false)
+, sharedMemory(NULL)
+, sharedMemoryRunning(false)
+, thread      (NULL)
+, locked      (false)
+, connected   (false)
+{
+	this->mode3d = mode3d;
+	
+	if (port>0) {
+		stream = TuioStreamReceiver::connectTcp(host,port);
+		if (stream!=NULL) std::cout << "receiving TUIO messages from TCP port " << port << " of " << host << std::endl;
+	} else {
+		stream = TuioStreamReceiver::connectUnix(host);
+		if (stream!=NULL) std::cout << "receiving TUIO messages from Unix socket " << host << std::endl;
+	}
+}
+
 TuioClient::~TuioClient() {	
 	delete socket;
+	for (int i=0;i<sourceCount;i++) delete sources[i];
+	delete jitterBuffer;
+	delete scheduler;
+	delete stream;
+	delete sharedMemory;
+	removeAllTuioListeners();
 }
 
 void TuioClient::ProcessBundle( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint) {
@@ -108,12 +193,15 @@ void TuioClient::ProcessBundle( const ReceivedBundle& b, const IpEndpointName& r
 			else
 				ProcessMessage( ReceivedMessage(*i), remoteEndpoint);
 		}
-	} catch (MalformedBundleException& e) {
-		std::cerr << "malformed OSC bundle: " << e.what() << std::endl;
+	} catch (Exception& e) {
+		// malformed messages within the bundle are dropped together with the rest of the bundle
+		TuioLog::text(TUIO_LOG_ERROR, "malformed OSC bundle: ", e.what());
 	}
 	
 }
 
+// the arguments have been validated while the message was received, so once its type tags
+// are known they are read without any further checks
 void TuioClient::ProcessMessage( const ReceivedMessage& msg, const IpEndpointName& remoteEndpoint) {
 	try {
 		ReceivedMessageArgumentStream args = msg.ArgumentStream();
@@ -123,511 +211,578 @@ void TuioClient::ProcessMessage( const ReceivedMessage& msg, const IpEndpointNam
 			
 			const char* cmd;
 			args >> cmd;
+			if (!selectSource(cmd,args,remoteEndpoint)) return;
 			
 			if (strcmp(cmd,"set")==0) {	
-												
-				int32 s_id, c_id;
-				float xpos, ypos, angle, xspeed, yspeed, rspeed, maccel, raccel;
-				args >> s_id >> c_id >> xpos >> ypos >> angle >> xspeed >> yspeed >> rspeed >> maccel >> raccel;
-				
-				lockObjectList();
-				std::list<TuioObject*>::iterator tobj;
-				for (tobj=objectList.begin(); tobj!= objectList.end(); tobj++)
-					if((*tobj)->getSessionID()==(long)s_id) break;
 				
-				if (tobj == objectList.end()) {
-					
-					TuioObject *addObject = new TuioObject((long)s_id,(int)c_id,xpos,ypos,angle);
-					frameObjects.push_back(addObject);
-
-				} else if ( ((*tobj)->getX()!=xpos) || ((*tobj)->getY()!=ypos) || ((*tobj)->getAngle()!=angle) || ((*tobj)->getXSpeed()!=xspeed) || ((*tobj)->getYSpeed()!=yspeed) || ((*tobj)->getRotationSpeed()!=rspeed) || ((*tobj)->getMotionAccel()!=maccel) || ((*tobj)->getRotationAccel()!=raccel) ) {
-
-					TuioObject *updateObject = new TuioObject((long)s_id,(*tobj)->getSymbolID(),xpos,ypos,angle);
-					updateObject->update(xpos,ypos,angle,xspeed,yspeed,rspeed,maccel,raccel);
-					frameObjects.push_back(updateObject);
-					
-				}
-				unlockObjectList();
+				if (!msg.HasTypeTags("siiffffffff")) throw WrongArgumentTypeException();
+				long s_id = sessionID((++arg)->AsInt32Unchecked());
+				int c_id = (int)(++arg)->AsInt32Unchecked();
+				float xpos = (++arg)->AsFloatUnchecked();
+				float ypos = (++arg)->AsFloatUnchecked();
+				float angle = (++arg)->AsFloatUnchecked();
+				float xspeed = (++arg)->AsFloatUnchecked();
+				float yspeed = (++arg)->AsFloatUnchecked();
+				float rspeed = (++arg)->AsFloatUnchecked();
+				float maccel = (++arg)->AsFloatUnchecked();
+				float raccel = (++arg)->AsFloatUnchecked();
+				processObjectSet(s_id,c_id,xpos,ypos,angle,xspeed,yspeed,rspeed,maccel,raccel);
 
 			} else if (strcmp(cmd,"alive")==0) {
 				
-				int32 s_id;
-				aliveObjectList.clear();
-				while(!args.Eos()) {
-					args >> s_id;
-					aliveObjectList.push_back((long)s_id);
-				}
+				processAlive(msg,aliveObjectList);
 				
 			} else if (strcmp(cmd,"fseq")==0) {
 				
 				int32 fseq;
 				args >> fseq;
-				bool lateFrame = false;
-				if (fseq>0) {
-					if (fseq>currentFrame) currentTime = TuioTime::getSessionTime();
-					if ((fseq>=currentFrame) || ((currentFrame-fseq)>100)) currentFrame = fseq;
-					else lateFrame = true;
-				} else if ((TuioTime::getSessionTime().getTotalMilliseconds()-currentTime.getTotalMilliseconds())>100) {
-					currentTime = TuioTime::getSessionTime();
-				}
-			
-				if (!lateFrame) {
-					
-					lockObjectList();
-					//find the removed objects first
-					for (std::list<TuioObject*>::iterator tobj=objectList.begin(); tobj != objectList.end(); tobj++) {
-						std::list<long>::iterator iter = find(aliveObjectList.begin(), aliveObjectList.end(), (*tobj)->getSessionID());
-						if (iter == aliveObjectList.end()) {
-							(*tobj)->remove(currentTime);
-							frameObjects.push_back(*tobj);							
-						}
-					}
-					unlockObjectList();
-					
-					for (std::list<TuioObject*>::iterator iter=frameObjects.begin(); iter != frameObjects.end(); iter++) {
-						TuioObject *tobj = (*iter);
-
-						TuioObject *frameObject = NULL;
-						switch (tobj->getTuioState()) {
-							case TUIO_REMOVED:
-								frameObject = tobj;
-								frameObject->remove(currentTime);
-
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->removeTuioObject(frameObject);
-
-								lockObjectList();								
-								for (std::list<TuioObject*>::iterator delobj=objectList.begin(); delobj!=objectList.end(); delobj++) {
-									if((*delobj)->getSessionID()==frameObject->getSessionID()) {
-										objectList.erase(delobj);
-										break;
-									}
-								}
-								unlockObjectList();
-								break;
-							case TUIO_ADDED:
-								
-								lockObjectList();
-								frameObject = new TuioObject(currentTime,tobj->getSessionID(),tobj->getSymbolID(),tobj->getX(),tobj->getY(),tobj->getAngle());
-								objectList.push_back(frameObject);
-								unlockObjectList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->addTuioObject(frameObject);
-								
-								break;
-							default:
-								
-								lockObjectList();
-								std::list<TuioObject*>::iterator iter;
-								for (iter=objectList.begin(); iter != objectList.end(); iter++) {
-									if((*iter)->getSessionID()==tobj->getSessionID()) {
-										frameObject = (*iter);
-										break;
-									}
-								}
-								if(iter==objectList.end()) break;
-								
-								if ( (tobj->getX()!=frameObject->getX() && tobj->getXSpeed()==0) || (tobj->getY()!=frameObject->getY() && tobj->getYSpeed()==0) )
-									frameObject->update(currentTime,tobj->getX(),tobj->getY(),tobj->getAngle());
-								else
-									frameObject->update(currentTime,tobj->getX(),tobj->getY(),tobj->getAngle(),tobj->getXSpeed(),tobj->getYSpeed(),tobj->getRotationSpeed(),tobj->getMotionAccel(),tobj->getRotationAccel());
-								unlockObjectList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->updateTuioObject(frameObject);
-								
-						}
-						delete tobj;
-					}
-
-					for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-						(*listener)->refresh(currentTime);
-					
-				} else {
-					for (std::list<TuioObject*>::iterator iter=frameObjects.begin(); iter != frameObjects.end(); iter++) {
-						TuioObject *tobj = (*iter);
-						delete tobj;
-					}
-				}
-				
-				frameObjects.clear();
+				processObjectFrame(fseq);
 			}
 		} else if( strcmp( msg.AddressPattern(), "/tuio/2Dcur" ) == 0 ) {
 			const char* cmd;
 			args >> cmd;
+			if (!selectSource(cmd,args,remoteEndpoint)) return;
 			
 			if (strcmp(cmd,"set")==0) {	
 
-				int32 s_id;
-				float xpos, ypos, xspeed, yspeed, maccel;				
-				args >> s_id >> xpos >> ypos >> xspeed >> yspeed >> maccel;
-				
-				lockCursorList();
-				std::list<TuioCursor*>::iterator tcur;
-				for (tcur=cursorList.begin(); tcur!= cursorList.end(); tcur++)
-					if((*tcur)->getSessionID()==(long)s_id) break;
-				
-				if (tcur==cursorList.end()) {
-									
-					TuioCursor *addCursor = new TuioCursor((long)s_id,-1,xpos,ypos);
-					frameCursors.push_back(addCursor);
-
-				} else if ( ((*tcur)->getX()!=xpos) || ((*tcur)->getY()!=ypos) || ((*tcur)->getXSpeed()!=xspeed) || ((*tcur)->getYSpeed()!=yspeed) || ((*tcur)->getMotionAccel()!=maccel) ) {
-
-					TuioCursor *updateCursor = new TuioCursor((long)s_id,(*tcur)->getCursorID(),xpos,ypos);
-					updateCursor->update(xpos,ypos,xspeed,yspeed,maccel);
-					frameCursors.push_back(updateCursor);
-
-				}
-				unlockCursorList();
+				if (!msg.HasTypeTags("sifffff")) throw WrongArgumentTypeException();
+				long s_id = sessionID((++arg)->AsInt32Unchecked());
+				float xpos = (++arg)->AsFloatUnchecked();
+				float ypos = (++arg)->AsFloatUnchecked();
+				float xspeed = (++arg)->AsFloatUnchecked();
+				float yspeed = (++arg)->AsFloatUnchecked();
+				float maccel = (++arg)->AsFloatUnchecked();
+				processCursorSet(s_id,xpos,ypos,0.0f,xspeed,yspeed,0.0f,maccel);
 				
 			} else if (strcmp(cmd,"alive")==0) {
 				
-				int32 s_id;
-				aliveCursorList.clear();
-				while(!args.Eos()) {
-					args >> s_id;
-					aliveCursorList.push_back((long)s_id);
-				}
+				processAlive(msg,aliveCursorList);
+				cursorAliveReceived = true;
 				
 			} else if( strcmp( cmd, "fseq" ) == 0 ){
 				
 				int32 fseq;
 				args >> fseq;
-				bool lateFrame = false;
-				if (fseq>0) {
-					if (fseq>currentFrame) currentTime = TuioTime::getSessionTime();
-					if ((fseq>=currentFrame) || ((currentFrame-fseq)>100)) currentFrame = fseq;
-					else lateFrame = true;
-				}  else if ((TuioTime::getSessionTime().getTotalMilliseconds()-currentTime.getTotalMilliseconds())>100) {
-					currentTime = TuioTime::getSessionTime();
-				}
-			
-				if (!lateFrame) {
-					
-					lockCursorList();
-					// find the removed cursors first
-					for (std::list<TuioCursor*>::iterator tcur=cursorList.begin(); tcur != cursorList.end(); tcur++) {
-						std::list<long>::iterator iter = find(aliveCursorList.begin(), aliveCursorList.end(), (*tcur)->getSessionID());
-							
-						if (iter == aliveCursorList.end()) {
-							(*tcur)->remove(currentTime);
-							frameCursors.push_back(*tcur);
-						}
-					}
-					unlockCursorList();
-					
-					for (std::list<TuioCursor*>::iterator iter=frameCursors.begin(); iter != frameCursors.end(); iter++) {
-						TuioCursor *tcur = (*iter);
-						
-						int c_id = -1;
-						TuioCursor *frameCursor = NULL;
-						switch (tcur->getTuioState()) {
-							case TUIO_REMOVED:
-								frameCursor = tcur;
-								frameCursor->remove(currentTime);
-	
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->removeTuioCursor(frameCursor);
-
-								lockCursorList();
-								for (std::list<TuioCursor*>::iterator delcur=cursorList.begin(); delcur!=cursorList.end(); delcur++) {
-									if((*delcur)->getSessionID()==frameCursor->getSessionID()) {
-										cursorList.erase(delcur);
-										break;
-									}
-								}
-
-								if (frameCursor->getCursorID()==maxCursorID) {
-									maxCursorID = -1;
-									delete frameCursor;
-									
-									if (cursorList.size()>0) {
-										std::list<TuioCursor*>::iterator clist;
-										for (clist=cursorList.begin(); clist != cursorList.end(); clist++) {
-											c_id = (*clist)->getCursorID();
-											if (c_id>maxCursorID) maxCursorID=c_id;
-										}
-			
-										freeCursorBuffer.clear();
-										for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-											TuioCursor *freeCursor = (*flist);
-											if (freeCursor->getCursorID()>maxCursorID) delete freeCursor;
-											else freeCursorBuffer.push_back(freeCursor);
-										}	
-										freeCursorList = freeCursorBuffer;
-
-									} else {
-										for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-											TuioCursor *freeCursor = (*flist);
-											delete freeCursor;
-										}
-										freeCursorList.clear();
-									}
-								} else if (frameCursor->getCursorID()<maxCursorID) {
-									freeCursorList.push_back(frameCursor);
-								} 
-								
-								unlockCursorList();
-								break;
-							case TUIO_ADDED:
-								
-								lockCursorList();
-								c_id = (int)cursorList.size();
-								if (((int)(cursorList.size())<=maxCursorID) && ((int)(freeCursorList.size())>0)) {
-									std::list<TuioCursor*>::iterator closestCursor = freeCursorList.begin();
-									
-									for(std::list<TuioCursor*>::iterator iter = freeCursorList.begin();iter!= freeCursorList.end(); iter++) {
-										if((*iter)->getDistance(tcur)<(*closestCursor)->getDistance(tcur)) closestCursor = iter;
-									}
-									
-									TuioCursor *freeCursor = (*closestCursor);
-									c_id = freeCursor->getCursorID();
-									freeCursorList.erase(closestCursor);
-									delete freeCursor;
-								} else maxCursorID = c_id;									
-								
-								frameCursor = new TuioCursor(currentTime,tcur->getSessionID(),c_id,tcur->getX(),tcur->getY());
-								cursorList.push_back(frameCursor);
-								
-								delete tcur;
-								unlockCursorList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->addTuioCursor(frameCursor);
-								
-								break;
-							default:
-								
-								lockCursorList();
-								std::list<TuioCursor*>::iterator iter;
-								for (iter=cursorList.begin(); iter != cursorList.end(); iter++) {
-									if((*iter)->getSessionID()==tcur->getSessionID()) {
-										frameCursor = (*iter);
-										break;
-									}
-								}
-								
-								if ( (tcur->getX()!=frameCursor->getX() && tcur->getXSpeed()==0) || (tcur->getY()!=frameCursor->getY() && tcur->getYSpeed()==0) )
-									frameCursor->update(currentTime,tcur->getX(),tcur->getY());
-								else
-									frameCursor->update(currentTime,tcur->getX(),tcur->getY(),tcur->getXSpeed(),tcur->getYSpeed(),tcur->getMotionAccel());
-						
-								delete tcur;
-								unlockCursorList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->updateTuioCursor(frameCursor);
-						}	
-					}
-					
-					for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-						(*listener)->refresh(currentTime);
-					
-				} else {
-					for (std::list<TuioCursor*>::iterator iter=frameCursors.begin(); iter != frameCursors.end(); iter++) {
-						TuioCursor *tcur = (*iter);
-						delete tcur;
-					}
-				}
-				
-				frameCursors.clear();
+				processCursorFrame(fseq);
 			} 
 		} else if( strcmp( msg.AddressPattern(), "/tuio/3Dcur" ) == 0 ) {
 			const char* cmd;
 			args >> cmd;
+			if (!selectSource(cmd,args,remoteEndpoint)) return;
 			
 			if (strcmp(cmd,"set")==0) {	
 
-				int32 s_id;
-				float xpos, ypos, zpos, xspeed, yspeed, zspeed, maccel;				
-				args >> s_id >> xpos >> ypos >> zpos >> xspeed >> yspeed >> zspeed >> maccel;
-				
-				lockCursorList();
-				std::list<TuioCursor*>::iterator tcur;
-				for (tcur=cursorList.begin(); tcur!= cursorList.end(); tcur++)
-					if((*tcur)->getSessionID()==(long)s_id) break;
-				
-				if (tcur==cursorList.end()) {
-									
-					TuioCursor *addCursor = new TuioCursor((long)s_id,-1,xpos,ypos,zpos);
-					frameCursors.push_back(addCursor);
-
-				} else if ( ((*tcur)->getX()!=xpos) || ((*tcur)->getY()!=ypos) || ((*tcur)->getZ()!=zpos) || ((*tcur)->getXSpeed()!=xspeed) || ((*tcur)->getYSpeed()!=yspeed) || ((*tcur)->getZSpeed()!=zspeed) || ((*tcur)->getMotionAccel()!=maccel) ) {
-
-					TuioCursor *updateCursor = new TuioCursor((long)s_id,(*tcur)->getCursorID(),xpos,ypos,zpos);
-					updateCursor->update(xpos,ypos,zpos,xspeed,yspeed,zspeed,maccel);
-					frameCursors.push_back(updateCursor);
-
-				}
-				unlockCursorList();
+				if (!msg.HasTypeTags("siffffffff")) throw WrongArgumentTypeException();
+				long s_id = sessionID((++arg)->AsInt32Unchecked());
+				float xpos = (++arg)->AsFloatUnchecked();
+				float ypos = (++arg)->AsFloatUnchecked();
+				float zpos = (++arg)->AsFloatUnchecked();
+				float xspeed = (++arg)->AsFloatUnchecked();
+				float yspeed = (++arg)->AsFloatUnchecked();
+				float zspeed = (++arg)->AsFloatUnchecked();
+				float maccel = (++arg)->AsFloatUnchecked();
+				processCursorSet(s_id,xpos,ypos,zpos,xspeed,yspeed,zspeed,maccel);
 				
 			} else if (strcmp(cmd,"alive")==0) {
 				
-				int32 s_id;
-				aliveCursorList.clear();
-				while(!args.Eos()) {
-					args >> s_id;
-					aliveCursorList.push_back((long)s_id);
-				}
+				processAlive(msg,aliveCursorList);
+				cursorAliveReceived = true;
 				
 			} else if( strcmp( cmd, "fseq" ) == 0 ){
 				
 				int32 fseq;
 				args >> fseq;
-				bool lateFrame = false;
-				if (fseq>0) {
-					if (fseq>currentFrame) currentTime = TuioTime::getSessionTime();
-					if ((fseq>=currentFrame) || ((currentFrame-fseq)>100)) currentFrame = fseq;
-					else lateFrame = true;
-				}  else if ((TuioTime::getSessionTime().getTotalMilliseconds()-currentTime.getTotalMilliseconds())>100) {
-					currentTime = TuioTime::getSessionTime();
+				processCursorFrame(fseq);
+			} 
+		}
+	} catch( Exception& e ){
+		TuioLog::text(TUIO_LOG_ERROR, "error parsing TUIO message: ", msg.AddressPattern(), e.what());
+	}
+}
+
+void TuioClient::processAlive(const ReceivedMessage& msg, std::vector<long> &aliveList) {
+	// all arguments following the command need to be Session IDs
+	const char *typeTags = msg.TypeTags()+1;
+	if (typeTags[strspn(typeTags,"i")]!='\0') throw WrongArgumentTypeException();
+	
+	aliveList.clear();
+	ReceivedMessage::const_iterator arg = msg.ArgumentsBegin();
+	for (++arg; arg!=msg.ArgumentsEnd(); ++arg)
+		aliveList.push_back(sessionID(arg->AsInt32Unchecked()));
+}
+
+void TuioClient::processObjectSet(long s_id, int c_id, float xpos, float ypos, float angle, float xspeed, float yspeed, float rspeed, float maccel, float raccel) {
+	if (currentSource!=NULL) currentSource->transform(xpos,ypos,xspeed,yspeed);
+	
+	lockObjectList();
+	TuioObject *tobj = objectSessions.find(s_id);
+	bool changed = (tobj==NULL) || (tobj->getX()!=xpos) || (tobj->getY()!=ypos) || (tobj->getAngle()!=angle) || (tobj->getXSpeed()!=xspeed) || (tobj->getYSpeed()!=yspeed) || (tobj->getRotationSpeed()!=rspeed) || (tobj->getMotionAccel()!=maccel) || (tobj->getRotationAccel()!=raccel);
+	unlockObjectList();
+	if (!changed) return;
+	
+	TuioObjectState tstate;
+	tstate.session_id = s_id;
+	tstate.symbol_id = c_id;
+	tstate.xpos = xpos;
+	tstate.ypos = ypos;
+	tstate.angle = angle;
+	tstate.x_speed = xspeed;
+	tstate.y_speed = yspeed;
+	tstate.rotation_speed = rspeed;
+	tstate.motion_accel = maccel;
+	tstate.rotation_accel = raccel;
+	frameObjects.push_back(tstate);
+}
+
+void TuioClient::processObjectFrame(int32 fseq) {
+	// the frames of merged sources are ordered separately for each source
+	int32 &lastFrame = (currentSource!=NULL)?currentSource->currentFrame:currentFrame;
+	bool lateFrame = false;
+	if (fseq>0) {
+		if (fseq>lastFrame) currentTime = TuioTime::getSessionTime();
+		if ((fseq>=lastFrame) || ((lastFrame-fseq)>100)) currentFrame = lastFrame = fseq;
+		else lateFrame = true;
+	} else if ((TuioTime::getSessionTime().getTotalMilliseconds()-currentTime.getTotalMilliseconds())>100) {
+		currentTime = TuioTime::getSessionTime();
+	}
+
+	if (!lateFrame) {
+		
+		// apply the whole frame at once, the removed objects remain valid until it has been dispatched
+		lockObjectList();
+		removedObjects.clear();
+		addedObjects.clear();
+		updatedObjects.clear();
+		objectStamp++;
+		int aliveCount = 0;
+		for (unsigned int i=0;i<aliveObjectList.size();i++) {
+			if (objectSessions.setStamp(aliveObjectList[i],objectStamp)) aliveCount++;
+		}
+		// the objects of other sources are not affected by the alive list of a merged source
+		if ((currentSource!=NULL) || (aliveCount<objectSessions.size())) {
+			std::list<TuioObject*>::iterator tobj=objectList.begin();
+			while (tobj != objectList.end()) {
+				if (objectSessions.hasStamp((*tobj)->getSessionID(),objectStamp)) tobj++;
+				else if ((currentSource!=NULL) && (!currentSource->ownsSessionID((*tobj)->getSessionID()))) tobj++;
+				else {
+					(*tobj)->remove(currentTime);
+					removedObjects.push_back(*tobj);
+					objectSessions.remove((*tobj)->getSessionID());
+					tobj = objectList.erase(tobj);
 				}
+			}
+		}
+		
+		for (unsigned int i=0;i<frameObjects.size();i++) {
+			const TuioObjectState &tstate = frameObjects[i];
 			
-				if (!lateFrame) {
-					
-					lockCursorList();
-					// find the removed cursors first
-					for (std::list<TuioCursor*>::iterator tcur=cursorList.begin(); tcur != cursorList.end(); tcur++) {
-						std::list<long>::iterator iter = find(aliveCursorList.begin(), aliveCursorList.end(), (*tcur)->getSessionID());
-							
-						if (iter == aliveCursorList.end()) {
-							(*tcur)->remove(currentTime);
-							frameCursors.push_back(*tcur);
-						}
-					}
-					unlockCursorList();
-					
-					for (std::list<TuioCursor*>::iterator iter=frameCursors.begin(); iter != frameCursors.end(); iter++) {
-						TuioCursor *tcur = (*iter);
-						
-						int c_id = -1;
-						TuioCursor *frameCursor = NULL;
-						switch (tcur->getTuioState()) {
-							case TUIO_REMOVED:
-								frameCursor = tcur;
-								frameCursor->remove(currentTime);
-	
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->removeTuioCursor(frameCursor);
-
-								lockCursorList();
-								for (std::list<TuioCursor*>::iterator delcur=cursorList.begin(); delcur!=cursorList.end(); delcur++) {
-									if((*delcur)->getSessionID()==frameCursor->getSessionID()) {
-										cursorList.erase(delcur);
-										break;
-									}
-								}
-
-								if (frameCursor->getCursorID()==maxCursorID) {
-									maxCursorID = -1;
-									delete frameCursor;
-									
-									if (cursorList.size()>0) {
-										std::list<TuioCursor*>::iterator clist;
-										for (clist=cursorList.begin(); clist != cursorList.end(); clist++) {
-											c_id = (*clist)->getCursorID();
-											if (c_id>maxCursorID) maxCursorID=c_id;
-										}
+			TuioObject *frameObject = objectSessions.find(tstate.session_id);
+			if (frameObject==NULL) {
+				frameObject = new TuioObject(currentTime,tstate.session_id,tstate.symbol_id,tstate.xpos,tstate.ypos,tstate.angle);
+				objectList.push_back(frameObject);
+				objectSessions.insert(tstate.session_id,frameObject);
+				addedObjects.push_back(frameObject);
+			} else {
+				// update the persistent object in place
+				if ( (tstate.xpos!=frameObject->getX() && tstate.x_speed==0) || (tstate.ypos!=frameObject->getY() && tstate.y_speed==0) )
+					frameObject->update(currentTime,tstate.xpos,tstate.ypos,tstate.angle);
+				else
+					frameObject->update(currentTime,tstate.xpos,tstate.ypos,tstate.angle,tstate.x_speed,tstate.y_speed,tstate.rotation_speed,tstate.motion_accel,tstate.rotation_accel);
+				updatedObjects.push_back(frameObject);
+			}
+		}
+		unlockObjectList();
+
+		publishSnapshot();
+		
+		TuioObjectFrame frame;
+		frame.frameTime = currentTime;
+		frame.frameID = currentFrame;
+		frame.added = addedObjects.empty()?NULL:&addedObjects[0];
+		frame.addedCount = (int)addedObjects.size();
+		frame.updated = updatedObjects.empty()?NULL:&updatedObjects[0];
+		frame.updatedCount = (int)updatedObjects.size();
+		frame.removed = removedObjects.empty()?NULL:&removedObjects[0];
+		frame.removedCount = (int)removedObjects.size();
+		for (std::list<TuioFrameListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
+			(*listener)->objectFrame(frame);
+		
+		for (unsigned int i=0;i<removedObjects.size();i++) delete removedObjects[i];
+		removedObjects.clear();
+	}
+	
+	frameObjects.clear();
+}
+
+// 2D cursors are processed as 3D cursors with a constant Z coordinate of zero
+void TuioClient::processCursorSet(long s_id, float xpos, float ypos, float zpos, float xspeed, float yspeed, float zspeed, float maccel) {
+	if (currentSource!=NULL) currentSource->transform(xpos,ypos,xspeed,yspeed);
+	
+	TuioCursorState tstate;
+	tstate.session_id = s_id;
+	tstate.cursor_id = -1;
+	tstate.xpos = xpos;
+	tstate.ypos = ypos;
+	tstate.zpos = zpos;
+	tstate.x_speed = xspeed;
+	tstate.y_speed = yspeed;
+	tstate.z_speed = zspeed;
+	tstate.motion_accel = maccel;
+	frameCursors.push_back(tstate);
+}
+
+void TuioClient::processCursorFrame(int32 fseq) {
+	// the jitter buffer releases the frames in order from the timer callback
+	if ((jitterBuffer!=NULL) && (fseq>0) && (currentSource==NULL)) {
+		lockCursorList();
+		jitterBuffer->insert(fseq,TuioTime::getSessionTime().getTotalMilliseconds(),frameCursors,cursorAliveReceived?&aliveCursorList:NULL);
+		unlockCursorList();
+		frameCursors.clear();
+		cursorAliveReceived = false;
+		return;
+	}
+	cursorAliveReceived = false;
+	
+	int32 &lastFrame = (currentSource!=NULL)?currentSource->currentFrame:currentFrame;
+	bool lateFrame = false;
+	if (fseq>0) {
+		if (fseq>lastFrame) currentTime = TuioTime::getSessionTime();
+		if ((fseq>=lastFrame) || ((lastFrame-fseq)>100)) currentFrame = lastFrame = fseq;
+		else lateFrame = true;
+	}  else if ((TuioTime::getSessionTime().getTotalMilliseconds()-currentTime.getTotalMilliseconds())>100) {
+		currentTime = TuioTime::getSessionTime();
+	}
+
+	if (!lateFrame) applyCursorFrame(frameCursors,&aliveCursorList,currentSource);
+	frameCursors.clear();
+}
+
+void TuioClient::applyCursorFrame(const std::vector<TuioCursorState> &cursors, const std::vector<long> *alive, const TuioSource *source) {
+	// apply the whole frame at once, the removed cursors remain valid until it has been dispatched
+	lockCursorList();
+	removedCursors.clear();
+	addedCursors.clear();
+	updatedCursors.clear();
+	cursorStamp++;
+	int aliveCount = 0;
+	// without an alive list all current cursors are kept
+	if (alive!=NULL) for (unsigned int i=0;i<alive->size();i++) {
+		if (cursorSessions.setStamp((*alive)[i],cursorStamp)) aliveCount++;
+	}
+	// the cursors of other sources are not affected by the alive list of a merged source
+	if ((alive!=NULL) && ((source!=NULL) || (aliveCount<cursorSessions.size()))) {
+		std::list<TuioCursor*>::iterator tcur=cursorList.begin();
+		while (tcur != cursorList.end()) {
+			if (cursorSessions.hasStamp((*tcur)->getSessionID(),cursorStamp)) tcur++;
+			else if ((source!=NULL) && (!source->ownsSessionID((*tcur)->getSessionID()))) tcur++;
+			else {
+				(*tcur)->remove(currentTime);
+				removedCursors.push_back(*tcur);
+				cursorSessions.remove((*tcur)->getSessionID());
+				cursorIdAllocator.release((*tcur)->getCursorID(),(*tcur)->getX(),(*tcur)->getY(),(*tcur)->getZ());
+				tcur = cursorList.erase(tcur);
+			}
+		}
+	}
+	
+	for (unsigned int i=0;i<cursors.size();i++) {
+		const TuioCursorState &tstate = cursors[i];
+		
+		TuioCursor *frameCursor = cursorSessions.find(tstate.session_id);
+		if (frameCursor==NULL) {
+			int c_id = cursorIdAllocator.allocate(tstate.xpos,tstate.ypos,tstate.zpos);
+			frameCursor = new TuioCursor(currentTime,tstate.session_id,c_id,tstate.xpos,tstate.ypos,tstate.zpos);
+			cursorList.push_back(frameCursor);
+			cursorSessions.insert(tstate.session_id,frameCursor);
+			addedCursors.push_back(frameCursor);
+		} else {
+			if ((tstate.xpos==frameCursor->getX()) && (tstate.ypos==frameCursor->getY()) && (tstate.zpos==frameCursor->getZ()) && (tstate.x_speed==frameCursor->getXSpeed()) && (tstate.y_speed==frameCursor->getYSpeed()) && (tstate.z_speed==frameCursor->getZSpeed()) && (tstate.motion_accel==frameCursor->getMotionAccel())) continue;
 			
-										freeCursorBuffer.clear();
-										for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-											TuioCursor *freeCursor = (*flist);
-											if (freeCursor->getCursorID()>maxCursorID) delete freeCursor;
-											else freeCursorBuffer.push_back(freeCursor);
-										}	
-										freeCursorList = freeCursorBuffer;
-
-									} else {
-										for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-											TuioCursor *freeCursor = (*flist);
-											delete freeCursor;
-										}
-										freeCursorList.clear();
-									}
-								} else if (frameCursor->getCursorID()<maxCursorID) {
-									freeCursorList.push_back(frameCursor);
-								} 
-								
-								unlockCursorList();
-								break;
-							case TUIO_ADDED:
-								
-								lockCursorList();
-								c_id = (int)cursorList.size();
-								if (((int)(cursorList.size())<=maxCursorID) && ((int)(freeCursorList.size())>0)) {
-									std::list<TuioCursor*>::iterator closestCursor = freeCursorList.begin();
-									
-									for(std::list<TuioCursor*>::iterator iter = freeCursorList.begin();iter!= freeCursorList.end(); iter++) {
-										if((*iter)->getDistance(tcur)<(*closestCursor)->getDistance(tcur)) closestCursor = iter;
-									}
-									
-									TuioCursor *freeCursor = (*closestCursor);
-									c_id = freeCursor->getCursorID();
-									freeCursorList.erase(closestCursor);
-									delete freeCursor;
-								} else maxCursorID = c_id;									
-								
-								frameCursor = new TuioCursor(currentTime,tcur->getSessionID(),c_id,tcur->getX(),tcur->getY(), tcur->getZ());
-								cursorList.push_back(frameCursor);
-								
-								delete tcur;
-								unlockCursorList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->addTuioCursor(frameCursor);
-								
-								break;
-							default:
-								
-								lockCursorList();
-								std::list<TuioCursor*>::iterator iter;
-								for (iter=cursorList.begin(); iter != cursorList.end(); iter++) {
-									if((*iter)->getSessionID()==tcur->getSessionID()) {
-										frameCursor = (*iter);
-										break;
-									}
-								}
-								
-								if ( (tcur->getX()!=frameCursor->getX() && tcur->getXSpeed()==0) || (tcur->getY()!=frameCursor->getY() && tcur->getYSpeed()==0) || (tcur->getZ()!=frameCursor->getZ() && tcur->getZSpeed()==0) )
-									frameCursor->update(currentTime,tcur->getX(),tcur->getY(),tcur->getZ());
-								else
-									frameCursor->update(currentTime,tcur->getX(),tcur->getY(),tcur->getZ(),tcur->getXSpeed(),tcur->getYSpeed(),tcur->getZSpeed(),tcur->getMotionAccel());
-						
-								delete tcur;
-								unlockCursorList();
-								
-								for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-									(*listener)->updateTuioCursor(frameCursor);
-						}	
-					}
-					
-					for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
-						(*listener)->refresh(currentTime);
-					
-				} else {
-					for (std::list<TuioCursor*>::iterator iter=frameCursors.begin(); iter != frameCursors.end(); iter++) {
-						TuioCursor *tcur = (*iter);
-						delete tcur;
-					}
-				}
-				
-				frameCursors.clear();
-			} 
+			// update the persistent cursor in place
+			if ( (tstate.xpos!=frameCursor->getX() && tstate.x_speed==0) || (tstate.ypos!=frameCursor->getY() && tstate.y_speed==0) || (tstate.zpos!=frameCursor->getZ() && tstate.z_speed==0) )
+				frameCursor->update(currentTime,tstate.xpos,tstate.ypos,tstate.zpos);
+			else
+				frameCursor->update(currentTime,tstate.xpos,tstate.ypos,tstate.zpos,tstate.x_speed,tstate.y_speed,tstate.z_speed,tstate.motion_accel);
+			updatedCursors.push_back(frameCursor);
 		}
-	} catch( Exception& e ){
-		std::cerr << "error parsing TUIO message: "<< msg.AddressPattern() <<  " - " << e.what() << std::endl;
+	}
+	unlockCursorList();
+	
+	publishSnapshot();
+	
+	TuioCursorFrame frame;
+	frame.frameTime = currentTime;
+	frame.frameID = currentFrame;
+	frame.added = addedCursors.empty()?NULL:&addedCursors[0];
+	frame.addedCount = (int)addedCursors.size();
+	frame.updated = updatedCursors.empty()?NULL:&updatedCursors[0];
+	frame.updatedCount = (int)updatedCursors.size();
+	frame.removed = removedCursors.empty()?NULL:&removedCursors[0];
+	frame.removedCount = (int)removedCursors.size();
+	for (std::list<TuioFrameListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
+		(*listener)->cursorFrame(frame);
+	
+	for (unsigned int i=0;i<removedCursors.size();i++) delete removedCursors[i];
+	removedCursors.clear();
+}
+
+void TuioClient::TimerExpired() {
+	if (scheduler!=NULL) releaseScheduledBundles();
+	if (jitterBuffer!=NULL) releaseJitterFrames();
+}
+
+void TuioClient::releaseScheduledBundles() {
+	const char *data;
+	int size;
+	IpEndpointName remoteEndpoint;
+	TuioSource *source;
+	while (scheduler->next(data,size,remoteEndpoint,source)) processOscPacket(source,data,size,remoteEndpoint);
+}
+
+void TuioClient::releaseJitterFrames() {
+	long now = TuioTime::getSessionTime().getTotalMilliseconds();
+	long fseq;
+	bool hasAlive;
+	float weight;
+	
+	for (;;) {
+		lockCursorList();
+		int result = jitterBuffer->next(now,fseq,jitterCursors,jitterAlive,hasAlive,weight);
+		if (result==TUIO_JITTER_MISSING) {
+			// move the known cursors towards the next buffered frame and keep all cursors alive
+			unsigned int count = 0;
+			for (unsigned int i=0;i<jitterCursors.size();i++) {
+				TuioCursorState tstate = jitterCursors[i];
+				TuioCursor *tcur = cursorSessions.find(tstate.session_id);
+				if (tcur==NULL) continue;
+				tstate.xpos = tcur->getX() + (tstate.xpos-tcur->getX())*weight;
+				tstate.ypos = tcur->getY() + (tstate.ypos-tcur->getY())*weight;
+				tstate.zpos = tcur->getZ() + (tstate.zpos-tcur->getZ())*weight;
+				jitterCursors[count++] = tstate;
+			}
+			jitterCursors.resize(count);
+		}
+		unlockCursorList();
+		if (result==TUIO_JITTER_NONE) return;
+		
+		currentFrame = fseq;
+		currentTime = TuioTime::getSessionTime();
+		applyCursorFrame(jitterCursors,hasAlive?&jitterAlive:NULL,NULL);
+	}
+}
+
+void TuioClient::enableSourceMerging() {
+	sourceMerging = true;
+}
+
+TuioSource* TuioClient::addTuioSource(int port, float scaleX, float scaleY, float offsetX, float offsetY) {
+	if ((socket==NULL) || (sourceCount==TUIO_MAX_SOURCES)) return NULL;
+	
+	UdpReceiveSocket *sourceSocket = NULL;
+	try {
+		sourceSocket = new UdpReceiveSocket(IpEndpointName( IpEndpointName::ANY_ADDRESS, port ));
+	} catch (std::exception &e) { 
+		std::cerr << "could not bind to UDP port " << port << std::endl;
+		return NULL;
+	}
+	
+	char name[TUIO_SOURCE_NAME];
+	sprintf(name,"udp:%d",port);
+	TuioSource *source = addTuioSource(name,scaleX,scaleY,offsetX,offsetY);
+	source->socket = sourceSocket;
+	socket->AttachSocketListener(sourceSocket,source);
+	std::cout << "listening to TUIO messages on UDP port " << port << std::endl;
+	return source;
+}
+
+TuioSource* TuioClient::addTuioSource(const char *name, float scaleX, float scaleY, float offsetX, float offsetY) {
+	if (sourceCount==TUIO_MAX_SOURCES) return NULL;
+	
+	sourceMerging = true;
+	TuioSource *source = new TuioSource(this,sourceCount,name,scaleX,scaleY,offsetX,offsetY);
+	sources[sourceCount++] = source;
+	return source;
+}
+
+// returns the source with the provided name, which is added if it is not known yet
+TuioSource* TuioClient::findTuioSource(const char *name) {
+	for (int i=0;i<sourceCount;i++) {
+		if (strcmp(sources[i]->getName(),name)==0) return sources[i];
+	}
+	if (sourceCount==TUIO_MAX_SOURCES) {
+		TuioLog::text(TUIO_LOG_ERROR, "too many TUIO sources, ignoring ", name);
+		return NULL;
+	}
+	
+	lockCursorList();
+	lockObjectList();
+	TuioSource *source = new TuioSource(this,sourceCount,name,1.0f,1.0f,0.0f,0.0f);
+	sources[sourceCount++] = source;
+	unlockObjectList();
+	unlockCursorList();
+	TuioLog::text(TUIO_LOG_INFO, "merging TUIO source ", name);
+	return source;
+}
+
+// selects the source of the following messages and returns false if the message has been consumed or has to be ignored
+bool TuioClient::selectSource(const char *cmd, ReceivedMessageArgumentStream &args, const IpEndpointName &remoteEndpoint) {
+	if (!sourceMerging) return true;
+	
+	if (strcmp(cmd,"source")==0) {
+		const char *name;
+		args >> name;
+		if ((currentSource==NULL) || (currentSource->socket==NULL)) currentSource = findTuioSource(name);
+		return false;
+	}
+	
+	if (currentSource==NULL) {
+		char name[IpEndpointName::ADDRESS_AND_PORT_STRING_LENGTH];
+		remoteEndpoint.AddressAndPortAsString(name);
+		currentSource = findTuioSource(name);
+	}
+	return (currentSource!=NULL);
+}
+
+TuioSource* TuioClient::getTuioSource(long s_id) {
+	if (!sourceMerging) return NULL;
+	
+	lockCursorList();
+	lockObjectList();
+	int index = (int)(s_id%TUIO_MAX_SOURCES);
+	TuioSource *source = ((index>=0) && (index<sourceCount))?sources[index]:NULL;
+	unlockObjectList();
+	unlockCursorList();
+	return source;
+}
+
+void TuioClient::enableJitterBuffer(int delay) {
+	if (socket==NULL) return;
+	if (jitterBuffer==NULL) {
+		jitterBuffer = new TuioJitterBuffer(delay);
+		updateTimer();
+	} else jitterBuffer->setDelay(delay);
+}
+
+void TuioClient::disableJitterBuffer() {
+	if (jitterBuffer==NULL) return;
+	delete jitterBuffer;
+	jitterBuffer = NULL;
+	updateTimer();
+}
+
+void TuioClient::enableBundleScheduling(int horizon) {
+	if (socket==NULL) return;
+	delete scheduler;
+	scheduler = new TuioBundleScheduler(horizon);
+	updateTimer();
+}
+
+void TuioClient::disableBundleScheduling() {
+	if (scheduler==NULL) return;
+	delete scheduler;
+	scheduler = NULL;
+	updateTimer();
+}
+
+// the scheduled bundles and the jitter buffer share a single timer with the shorter tick
+void TuioClient::updateTimer() {
+	int tick = 0;
+	if (scheduler!=NULL) tick = TUIO_SCHEDULE_TICK;
+	else if (jitterBuffer!=NULL) tick = TUIO_JITTER_TICK;
+	if (tick==timerTick) return;
+	
+	if (timerTick>0) socket->DetachPeriodicTimerListener(this);
+	if (tick>0) socket->AttachPeriodicTimerListener(tick,this);
+	timerTick = tick;
+}
+
+TuioJitterStats TuioClient::getJitterStats() {
+	TuioJitterStats stats;
+	memset(&stats,0,sizeof(stats));
+	if (jitterBuffer==NULL) return stats;
+	
+	lockCursorList();
+	stats = jitterBuffer->getStats();
+	unlockCursorList();
+	return stats;
+}
+
+void TuioClient::publishSnapshot() {
+	TuioClientSnapshot *snapshot = snapshots.claim();
+	if (snapshot==NULL) {
+		TuioLog::text(TUIO_LOG_WARNING, "all TUIO client snapshots are held");
+		return;
+	}
+	
+	snapshot->cursors.resize(cursorList.size());
+	int i = 0;
+	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++)
+		(*iter)->getState(snapshot->cursors[i++]);
+	
+	snapshot->objects.resize(objectList.size());
+	i = 0;
+	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++)
+		(*iter)->getState(snapshot->objects[i++]);
+	
+	snapshot->frameTime = currentTime;
+	snapshot->frameID = currentFrame;
+	snapshots.publish(snapshot);
+}
+
+void TuioClient::processSharedFrame() {
+	long fseq;
+	int truncated;
+	if (!sharedMemory->read(fseq,sharedCursors,sharedObjects,truncated)) return;
+	
+	// a shared frame holds the complete state, so it is processed like a full update,
+	// unless a list has been truncated, which keeps the previous state instead of removing the missing ones
+	if (truncated & TUIO_SHM_CURSORS_TRUNCATED) TuioLog::text(TUIO_LOG_WARNING, "too many cursors in shared frame, keeping the previous cursors");
+	else {
+		aliveCursorList.clear();
+		for (unsigned int i=0;i<sharedCursors.size();i++) {
+			const TuioCursorState &tstate = sharedCursors[i];
+			aliveCursorList.push_back(tstate.session_id);
+			processCursorSet(tstate.session_id,tstate.xpos,tstate.ypos,tstate.zpos,tstate.x_speed,tstate.y_speed,tstate.z_speed,tstate.motion_accel);
+		}
+		processCursorFrame((int32)fseq);
+	}
+	
+	if (truncated & TUIO_SHM_OBJECTS_TRUNCATED) TuioLog::text(TUIO_LOG_WARNING, "too many objects in shared frame, keeping the previous objects");
+	else {
+		aliveObjectList.clear();
+		for (unsigned int i=0;i<sharedObjects.size();i++) {
+			const TuioObjectState &tstate = sharedObjects[i];
+			aliveObjectList.push_back(tstate.session_id);
+			processObjectSet(tstate.session_id,tstate.symbol_id,tstate.xpos,tstate.ypos,tstate.angle,tstate.x_speed,tstate.y_speed,tstate.rotation_speed,tstate.motion_accel,tstate.rotation_accel);
+		}
+		processObjectFrame((int32)fseq);
+	}
+}
+
+void TuioClient::runSharedMemory() {
+	while (sharedMemoryRunning) {
+		if (sharedMemory->wait(100)) processSharedFrame();
 	}
 }
 
 void TuioClient::ProcessPacket( const char *data, int size, const IpEndpointName& remoteEndpoint ) {
+	processSourcePacket(NULL, data, size, remoteEndpoint);
+}
+
+void TuioClient::processSourcePacket(TuioSource *source, const char *data, int size, const IpEndpointName &remoteEndpoint) {
+	if ((scheduler!=NULL) && (scheduler->schedule(data,size,remoteEndpoint,source))) return;
+	processOscPacket(source,data,size,remoteEndpoint);
+}
+
+// the source of packets received on the main port is only known from their messages
+void TuioClient::processOscPacket(TuioSource *source, const char *data, int size, const IpEndpointName &remoteEndpoint) {
+	currentSource = source;
 	try {
 		ReceivedPacket p( data, size );
 		if(p.IsBundle()) ProcessBundle( ReceivedBundle(p), remoteEndpoint);
 		else ProcessMessage( ReceivedMessage(p), remoteEndpoint);
-	} catch (MalformedBundleException& e) {
-		std::cerr << "malformed OSC bundle: " << e.what() << std::endl;
+	} catch (Exception& e) {
+		TuioLog::text(TUIO_LOG_ERROR, "malformed OSC packet: ", e.what());
 	}
 }
 
@@ -644,19 +799,30 @@ void TuioClient::connect(bool lk) {
 	objectMutex = CreateMutex(NULL,FALSE,"objectMutex");
 #endif		
 		
-	if (socket==NULL) return;
+	if ((socket==NULL) && (stream==NULL) && (sharedMemory==NULL)) return;
 	TuioTime::initSession();
 	currentTime.reset();
 	
 	locked = lk;
-	if (!locked) {
+	if (sharedMemory!=NULL) {
+		sharedMemoryRunning = true;
+		if (!locked) {
+#ifndef WIN32
+			pthread_create(&thread , NULL, sharedMemoryThreadFunc, this);
+#else
+			DWORD threadId;
+			thread = CreateThread( 0, 0, sharedMemoryThreadFunc, this, 0, &threadId );
+#endif
+		} else runSharedMemory();
+	} else if (!locked) {
 #ifndef WIN32
 		pthread_create(&thread , NULL, ClientThreadFunc, this);
 #else
 		DWORD threadId;
 		thread = CreateThread( 0, 0, ClientThreadFunc, this, 0, &threadId );
 #endif
-	} else socket->Run();
+	} else if (stream!=NULL) stream->Run(this);
+	else socket->Run();
 	
 	connected = true;
 	unlockCursorList();
@@ -665,8 +831,31 @@ void TuioClient::connect(bool lk) {
 
 void TuioClient::disconnect() {
 	
-	if (socket==NULL) return;
-	socket->Break();
+	if ((socket==NULL) && (stream==NULL) && (sharedMemory==NULL)) return;
+	
+	// the receive thread is stopped before the state is cleared, unless a listener is disconnecting from that thread
+	bool join = (connected && !locked);
+#ifndef WIN32
+	if (join && pthread_equal(thread,pthread_self())) join = false;
+#else
+	if (join && (GetThreadId(thread)==GetCurrentThreadId())) join = false;
+#endif
+	
+	if (socket!=NULL) {
+		if (join) socket->AsynchronousBreak();
+		else socket->Break();
+	}
+	if (stream!=NULL) stream->Break();
+	
+	// the shared memory thread wakes up at least every 100ms
+	if (sharedMemory!=NULL) sharedMemoryRunning = false;
+	if (join) {
+#ifndef WIN32
+		pthread_join(thread, NULL);
+#else
+		WaitForSingleObject(thread, INFINITE);
+#endif
+	}
 	
 	if (!locked) {
 #ifdef WIN32
@@ -690,49 +879,66 @@ void TuioClient::disconnect() {
 	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++)
 		delete (*iter);
 	objectList.clear();
+	objectSessions.clear();
 
 	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++)
 		delete (*iter);
 	cursorList.clear();
+	cursorSessions.clear();
 	
-	for (std::list<TuioCursor*>::iterator iter=freeCursorList.begin(); iter != freeCursorList.end(); iter++)
-		delete(*iter);
-	freeCursorList.clear();
+	cursorIdAllocator.clear();
+	if (jitterBuffer!=NULL) jitterBuffer->clear();
+	for (int i=0;i<sourceCount;i++) sources[i]->currentFrame = -1;
+	publishSnapshot();
 
 	connected = false;
 }
 
 void TuioClient::addTuioListener(TuioListener *listener) {
-	listenerList.push_back(listener);
+	TuioListenerAdapter *adapter = new TuioListenerAdapter(listener);
+	adapterList.push_back(adapter);
+	listenerList.push_back(adapter);
 }
 
 void TuioClient::removeTuioListener(TuioListener *listener) {
-	std::list<TuioListener*>::iterator result = find(listenerList.begin(),listenerList.end(),listener);
+	for (std::list<TuioListenerAdapter*>::iterator adapter=adapterList.begin(); adapter != adapterList.end(); adapter++) {
+		if ((*adapter)->getListener()==listener) {
+			listenerList.remove(*adapter);
+			delete (*adapter);
+			adapterList.erase(adapter);
+			return;
+		}
+	}
+}
+
+void TuioClient::addTuioFrameListener(TuioFrameListener *listener) {
+	listenerList.push_back(listener);
+}
+
+void TuioClient::removeTuioFrameListener(TuioFrameListener *listener) {
+	std::list<TuioFrameListener*>::iterator result = find(listenerList.begin(),listenerList.end(),listener);
 	if (result!=listenerList.end()) listenerList.remove(listener);
 }
 
+void TuioClient::removeAllTuioListeners() {
+	listenerList.clear();
+	for (std::list<TuioListenerAdapter*>::iterator adapter=adapterList.begin(); adapter != adapterList.end(); adapter++)
+		delete (*adapter);
+	adapterList.clear();
+}
+
 TuioObject* TuioClient::getTuioObject(long s_id) {
 	lockObjectList();
-	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++) {
-		if((*iter)->getSessionID()==s_id) {
-			unlockObjectList();
-			return (*iter);
-		}
-	}	
+	TuioObject *tobj = objectSessions.find(s_id);
 	unlockObjectList();
-	return NULL;
+	return tobj;
 }
 
 TuioCursor* TuioClient::getTuioCursor(long s_id) {
 	lockCursorList();
-	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++) {
-		if((*iter)->getSessionID()==s_id) {
-			unlockCursorList();
-			return (*iter);
-		}
-	}	
+	TuioCursor *tcur = cursorSessions.find(s_id);
 	unlockCursorList();
-	return NULL;
+	return tcur;
 }
 
 std::list<TuioObject*> TuioClient::getTuioObjects() {
@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include <list>
+#include <vector>
 #include <algorithm>
 #include <cstring>
 
@@ -39,17 +40,30 @@
 
 #include "ip/UdpSocket.h"
 #include "ip/PacketListener.h"
+#include "ip/TimerListener.h"
 
 #include "TuioListener.h"
+#include "TuioFrameListener.h"
 #include "TuioObject.h"
 #include "TuioCursor.h"
+#include "TuioIdAllocator.h"
+#include "TuioSessionMap.h"
+#include "TuioSnapshotPool.h"
+#include "TuioJitterBuffer.h"
+#include "TuioBundleScheduler.h"
+#include "TuioSource.h"
+#include "TuioClientSnapshot.h"
+#include "TuioSharedMemory.h"
+#include "TuioStreamReceiver.h"
+#include "TuioLog.h"
 
 namespace TUIO {
 	
 	/**
 	 * <p>The TuioClient class is the central TUIO protocol decoder component. It provides a simple callback infrastructure using the {@link TuioListener} interface.
 	 * In order to receive and decode TUIO messages an instance of TuioClient needs to be created. The TuioClient instance then generates TUIO events
-	 * which are broadcasted to all registered classes that implement the {@link TuioListener} interface.</p> 
+	 * which are broadcasted to all registered classes that implement the {@link TuioListener} interface.
+	 * Alternatively a {@link TuioFrameListener} receives all changes of each TUIO frame with a single callback.</p> 
 	 * <p><code>
 	 * TuioClient *client = new TuioClient();<br/>
 	 * client->addTuioListener(myTuioListener);<br/>
@@ -59,7 +73,9 @@ namespace TUIO {
 	 * @author Martin Kaltenbrunner
 	 * @version 1.4
 	 */ 
-	class TuioClient : public PacketListener { 
+	class TuioClient : public PacketListener, public TimerListener { 
+		
+		friend class TuioSource;
 		
 	public:
 		/**
@@ -69,6 +85,23 @@ namespace TUIO {
 		 */
 		TuioClient(int port=3333, bool mode3d = false);
 
+		/**
+		 * This constructor creates a TuioClient that reads the frames of a TuioServer on the same host
+		 * from the shared memory segment with the provided name instead of listening to a UDP port.
+		 *
+		 * @param  name  the name of the shared memory segment, such as TUIO_SHM_NAME
+		 */
+		TuioClient(const char *name, bool mode3d = false);
+
+		/**
+		 * This constructor creates a TuioClient that connects to the TCP port of a TuioServer,
+		 * or to its Unix domain socket if no port is provided, instead of listening to a UDP port.
+		 *
+		 * @param  host  the host name of the TuioServer, or the path of its Unix domain socket
+		 * @param  port  the TCP port of the TuioServer, or 0 for a Unix domain socket
+		 */
+		TuioClient(const char *host, int port, bool mode3d = false);
+
 		/**
 		 * The destructor is doing nothing in particular. 
 		 */
@@ -110,26 +143,158 @@ namespace TUIO {
 		void removeTuioListener(TuioListener *listener);
 
 		/**
-		 * Removes all TuioListener from the list of registered TUIO event listeners
+		 * Adds the provided TuioFrameListener to the list of registered TUIO event listeners,
+		 * which receives all changes of a TUIO frame with a single callback
+		 *
+		 * @param  listener  the TuioFrameListener to add
+		 */
+		void addTuioFrameListener(TuioFrameListener *listener);
+
+		/**
+		 * Removes the provided TuioFrameListener from the list of registered TUIO event listeners
+		 *
+		 * @param  listener  the TuioFrameListener to remove
+		 */
+		void removeTuioFrameListener(TuioFrameListener *listener);
+
+		/**
+		 * Removes all TuioListener and TuioFrameListener from the list of registered TUIO event listeners
+		 */
+		void removeAllTuioListeners();
+
+		/**
+		 * Buffers the received TuioCursor frames for the provided target delay, so they are released in order
+		 * of their fseq and evenly spaced, and interpolates missing frames. This is only available for UDP
+		 * and has to be called before connect(), or again to change the target delay.
+		 * TuioObject frames and frames without an fseq are not buffered.
+		 *
+		 * @param  delay  the target delay in milliseconds
+		 */
+		void enableJitterBuffer(int delay=TUIO_JITTER_DELAY);
+
+		/**
+		 * Processes the TuioCursor frames as they are received again. This has to be called before connect().
+		 */
+		void disableJitterBuffer();
+
+		/**
+		 * Returns true if the received TuioCursor frames are buffered.
+		 * @return  true if the received TuioCursor frames are buffered
+		 */
+		bool jitterBufferEnabled() { return (jitterBuffer!=NULL); }
+
+		/**
+		 * Returns the statistics of the jitter buffer, which are all zero if it is not enabled.
+		 * @return  the statistics of the jitter buffer
+		 */
+		TuioJitterStats getJitterStats();
+
+		/**
+		 * Holds the received OSC bundles whose time tag is in the future until they are due, so TUIO servers
+		 * can schedule their frames ahead to smooth out the network jitter. Immediate bundles and bundles which
+		 * are already due are processed as they are received. Bundles due later than the provided horizon
+		 * are processed at once as well, since the clocks of the server and the client are not synchronized.
+		 * This is only available for UDP and has to be called before connect().
+		 *
+		 * @param  horizon  the maximum time in milliseconds a bundle is held
+		 */
+		void enableBundleScheduling(int horizon=TUIO_SCHEDULE_HORIZON);
+
+		/**
+		 * Processes all received OSC bundles at once again. This has to be called before connect().
+		 */
+		void disableBundleScheduling();
+
+		/**
+		 * Returns true if received OSC bundles are held until their time tag.
+		 * @return  true if received OSC bundles are held until their time tag
 		 */
-		void removeAllTuioListeners() {	
-			listenerList.clear();
-		}
+		bool bundleSchedulingEnabled() { return (scheduler!=NULL); }
 
 		/**
-		 * Returns a List of all currently active TuioObjects
+		 * Merges the TuioCursors and TuioObjects of all TUIO servers sending to this TuioClient into one frame stream.
+		 * The servers are told apart by their source message or otherwise by their address and port,
+		 * and their Session IDs are namespaced by their {@link TuioSource}. This has to be called before connect().
+		 * The frames of merged sources are processed as they are received, even if the jitter buffer is enabled.
+		 */
+		void enableSourceMerging();
+
+		/**
+		 * Returns true if the TuioCursors and TuioObjects of several TUIO servers are merged.
+		 * @return  true if the TuioCursors and TuioObjects of several TUIO servers are merged
+		 */
+		bool sourceMergingEnabled() { return sourceMerging; }
+
+		/**
+		 * Additionally listens to the provided UDP port, all messages of which form one TuioSource,
+		 * whose coordinates are scaled and offset by the provided values. This enables source merging
+		 * and has to be called before connect().
+		 *
+		 * @param  port  the UDP port to listen to
+		 * @param  scaleX  the factor the X coordinates are scaled with
+		 * @param  scaleY  the factor the Y coordinates are scaled with
+		 * @param  offsetX  the offset added to the scaled X coordinates
+		 * @param  offsetY  the offset added to the scaled Y coordinates
+		 * @return  the added TuioSource or NULL if the port could not be bound or there are too many sources
+		 */
+		TuioSource* addTuioSource(int port, float scaleX=1.0f, float scaleY=1.0f, float offsetX=0.0f, float offsetY=0.0f);
+
+		/**
+		 * Adds a TuioSource for the TUIO server with the provided source message name, or address and port
+		 * such as 192.168.0.2:50000, whose coordinates are scaled and offset by the provided values.
+		 * This enables source merging and has to be called before connect().
+		 *
+		 * @param  name  the name of the TuioSource
+		 * @param  scaleX  the factor the X coordinates are scaled with
+		 * @param  scaleY  the factor the Y coordinates are scaled with
+		 * @param  offsetX  the offset added to the scaled X coordinates
+		 * @param  offsetY  the offset added to the scaled Y coordinates
+		 * @return  the added TuioSource or NULL if there are too many sources
+		 */
+		TuioSource* addTuioSource(const char *name, float scaleX=1.0f, float scaleY=1.0f, float offsetX=0.0f, float offsetY=0.0f);
+
+		/**
+		 * Returns the TuioSource the provided Session ID belongs to or NULL if sources are not merged.
+		 *
+		 * @param  s_id  the Session ID of a TuioCursor or TuioObject
+		 * @return  the TuioSource of the Session ID or NULL
+		 */
+		TuioSource* getTuioSource(long s_id);
+
+		/**
+		 * Returns a List of all currently active TuioObjects.
+		 * The TuioObjects are deleted by the receiving thread once they have been removed,
+		 * use acquireSnapshot() to access them from other threads safely.
 		 *
 		 * @return  a List of all currently active TuioObjects
 		 */
 		std::list<TuioObject*> getTuioObjects();
 		
 		/**
-		 * Returns a List of all currently active TuioCursors
+		 * Returns a List of all currently active TuioCursors.
+		 * The TuioCursors are deleted by the receiving thread once they have been removed,
+		 * use acquireSnapshot() to access them from other threads safely.
 		 *
 		 * @return  a List of all currently active TuioCursors
 		 */
 		std::list<TuioCursor*> getTuioCursors();
 
+		/**
+		 * Returns the states of all TuioCursors and TuioObjects after the most recently received frame
+		 * without any locks. The TuioClientSnapshot does not change until it is released again.
+		 * Since only TUIO_SNAPSHOT_POOL snapshots exist, it should be released as soon as possible.
+		 *
+		 * @return  the most recent TuioClientSnapshot
+		 */
+		const TuioClientSnapshot* acquireSnapshot() { return snapshots.acquire(); }
+
+		/**
+		 * Releases the provided TuioClientSnapshot.
+		 *
+		 * @param  snapshot  the TuioClientSnapshot returned by acquireSnapshot()
+		 */
+		void releaseSnapshot(const TuioClientSnapshot *snapshot) { snapshots.release(snapshot); }
+
 		/**
 		 * Returns the TuioObject corresponding to the provided Session ID
 		 * or NULL if the Session ID does not refer to an active TuioObject
@@ -167,7 +332,9 @@ namespace TUIO {
 		void unlockCursorList();
 
 		void ProcessPacket( const char *data, int size, const IpEndpointName &remoteEndpoint );
+		void TimerExpired();
 		UdpListeningReceiveSocket *socket;
+		TuioStreamReceiver *stream;
 				
 	protected:
 		void ProcessBundle( const osc::ReceivedBundle& b, const IpEndpointName& remoteEndpoint);
@@ -182,18 +349,80 @@ namespace TUIO {
 		void ProcessMessage( const osc::ReceivedMessage& message, const IpEndpointName& remoteEndpoint);
 		
 	private:
-		std::list<TuioListener*> listenerList;
+		void processAlive(const osc::ReceivedMessage& msg, std::vector<long> &aliveList);
+		void processObjectSet(long s_id, int c_id, float xpos, float ypos, float angle, float xspeed, float yspeed, float rspeed, float maccel, float raccel);
+		void processObjectFrame(osc::int32 fseq);
+		void processCursorSet(long s_id, float xpos, float ypos, float zpos, float xspeed, float yspeed, float zspeed, float maccel);
+		void processCursorFrame(osc::int32 fseq);
+		void applyCursorFrame(const std::vector<TuioCursorState> &cursors, const std::vector<long> *alive, const TuioSource *source);
+		
+		void processSourcePacket(TuioSource *source, const char *data, int size, const IpEndpointName &remoteEndpoint);
+		void processOscPacket(TuioSource *source, const char *data, int size, const IpEndpointName &remoteEndpoint);
+		bool selectSource(const char *cmd, osc::ReceivedMessageArgumentStream &args, const IpEndpointName &remoteEndpoint);
+		TuioSource* findTuioSource(const char *name);
+		long sessionID(osc::int32 s_id) { return (currentSource!=NULL)?currentSource->getSessionID(s_id):(long)s_id; }
+		
+		void publishSnapshot();
+		
+		void releaseScheduledBundles();
+		void releaseJitterFrames();
+		void updateTimer();
+		
+		void processSharedFrame();
+		void runSharedMemory();
+#ifndef WIN32
+		static void* sharedMemoryThreadFunc(void *obj);
+#else
+		static DWORD WINAPI sharedMemoryThreadFunc(LPVOID obj);
+#endif
+		
+
+		// the TuioListeners are registered through a TuioListenerAdapter each
+		std::list<TuioFrameListener*> listenerList;
+		std::list<TuioListenerAdapter*> adapterList;
 		
-		std::list<TuioObject*> objectList, frameObjects;
-		std::list<long> aliveObjectList;
-		std::list<TuioCursor*> cursorList, frameCursors;
-		std::list<long> aliveCursorList;
+		std::list<TuioObject*> objectList;
+		std::list<TuioCursor*> cursorList;
+		
+		// the sessions are looked up through hash maps, and the received frames are staged in reused arrays
+		TuioSessionMap<TuioObject> objectSessions;
+		TuioSessionMap<TuioCursor> cursorSessions;
+		std::vector<TuioObjectState> frameObjects;
+		std::vector<TuioCursorState> frameCursors;
+		std::vector<TuioObject*> addedObjects;
+		std::vector<TuioObject*> updatedObjects;
+		std::vector<TuioObject*> removedObjects;
+		std::vector<TuioCursor*> addedCursors;
+		std::vector<TuioCursor*> updatedCursors;
+		std::vector<TuioCursor*> removedCursors;
+		std::vector<long> aliveObjectList;
+		std::vector<long> aliveCursorList;
+		bool cursorAliveReceived;
 		
 		osc::int32 currentFrame;
+		unsigned int objectStamp;
+		unsigned int cursorStamp;
 		TuioTime currentTime;
 			
-		std::list<TuioCursor*> freeCursorList, freeCursorBuffer;
-		int maxCursorID;
+		TuioIdAllocator cursorIdAllocator;
+		TuioSnapshotPool<TuioClientSnapshot> snapshots;
+		
+		TuioJitterBuffer *jitterBuffer;
+		std::vector<TuioCursorState> jitterCursors;
+		std::vector<long> jitterAlive;
+		
+		TuioBundleScheduler *scheduler;
+		int timerTick;
+		
+		TuioSource *sources[TUIO_MAX_SOURCES];
+		int sourceCount;
+		TuioSource *currentSource;
+		bool sourceMerging;
+		
+		TuioSharedMemory *sharedMemory;
+		std::vector<TuioCursorState> sharedCursors;
+		std::vector<TuioObjectState> sharedObjects;
+		volatile bool sharedMemoryRunning;
 
 		bool mode3d;
 		
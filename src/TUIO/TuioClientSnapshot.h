@@ -0,0 +1,128 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOCLIENTSNAPSHOT_H
+#define INCLUDED_TUIOCLIENTSNAPSHOT_H
+
+#include <vector>
+#include <cstddef>
+#include "TuioCursor.h"
+#include "TuioObject.h"
+#include "TuioTime.h"
+
+namespace TUIO {
+
+	/**
+	 * The TuioClientSnapshot class holds the states of all TuioCursors and TuioObjects of a TuioClient
+	 * after a completely received frame. A snapshot is acquired from the TuioClient without any locks
+	 * and does not change until it is released, so all references into it remain valid meanwhile.
+	 * <p><code>
+	 * const TuioClientSnapshot *snapshot = client->acquireSnapshot();<br/>
+	 * for (int i=0;i&lt;snapshot-&gt;getCursorCount();i++) draw(snapshot-&gt;getCursor(i));<br/>
+	 * client->releaseSnapshot(snapshot);<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	class TuioClientSnapshot {
+
+		friend class TuioClient;
+
+	private:
+		std::vector<TuioCursorState> cursors;
+		std::vector<TuioObjectState> objects;
+		TuioTime frameTime;
+		long frameID;
+
+	public:
+		/**
+		 * The default constructor creates an empty TuioClientSnapshot.
+		 */
+		TuioClientSnapshot():frameID(-1) {};
+
+		/**
+		 * Returns the time of the frame this TuioClientSnapshot has been taken after.
+		 * @return	the time of the frame
+		 */
+		TuioTime getFrameTime() const { return frameTime; }
+
+		/**
+		 * Returns the ID of the frame this TuioClientSnapshot has been taken after.
+		 * @return	the ID of the frame
+		 */
+		long getFrameID() const { return frameID; }
+
+		/**
+		 * Returns the number of TuioCursors.
+		 * @return	the number of TuioCursors
+		 */
+		int getCursorCount() const { return (int)cursors.size(); }
+
+		/**
+		 * Returns the state of the TuioCursor at the provided position.
+		 *
+		 * @param	index	the position within 0..getCursorCount()-1
+		 * @return	the state of the TuioCursor
+		 */
+		const TuioCursorState& getCursor(int index) const { return cursors[index]; }
+
+		/**
+		 * Returns the state of the TuioCursor with the provided Session ID or NULL if there is no such TuioCursor.
+		 *
+		 * @param	s_id	the Session ID of the TuioCursor
+		 * @return	the state of the TuioCursor or NULL
+		 */
+		const TuioCursorState* findCursor(long s_id) const {
+			for (unsigned int i=0;i<cursors.size();i++) {
+				if (cursors[i].session_id==s_id) return &cursors[i];
+			}
+			return NULL;
+		}
+
+		/**
+		 * Returns the number of TuioObjects.
+		 * @return	the number of TuioObjects
+		 */
+		int getObjectCount() const { return (int)objects.size(); }
+
+		/**
+		 * Returns the state of the TuioObject at the provided position.
+		 *
+		 * @param	index	the position within 0..getObjectCount()-1
+		 * @return	the state of the TuioObject
+		 */
+		const TuioObjectState& getObject(int index) const { return objects[index]; }
+
+		/**
+		 * Returns the state of the TuioObject with the provided Session ID or NULL if there is no such TuioObject.
+		 *
+		 * @param	s_id	the Session ID of the TuioObject
+		 * @return	the state of the TuioObject or NULL
+		 */
+		const TuioObjectState* findObject(long s_id) const {
+			for (unsigned int i=0;i<objects.size();i++) {
+				if (objects[i].session_id==s_id) return &objects[i];
+			}
+			return NULL;
+		}
+	};
+};
+#endif /* INCLUDED_TUIOCLIENTSNAPSHOT_H */
@@ -25,6 +25,8 @@
 #include <list>
 #include <math.h>
 #include "TuioPoint.h"
+#include "TuioPath.h"
+#include "TuioSlotMap.h"
 #include <iostream>
 
 #define TUIO_ADDED 0
@@ -69,14 +71,48 @@ namespace TUIO {
 		 */ 
 		float motion_accel;
 		/**
-		 * A List of TuioPoints containing all the previous positions of the TUIO component.
+		 * A TuioPath containing the most recent previous positions of the TUIO component.
 		 */ 
-		std::list<TuioPoint> path;
+		TuioPath path;
 		/**
 		 * Reflects the current state of the TuioComponent
-		 */ 
+		 */
 		int state;
-		
+		/**
+		 * The handle of this TuioContainer within the TuioSlotMap of its TuioServer.
+		 */
+		unsigned long long slot_handle;
+
+		/**
+		 * Reinitializes this TuioContainer like the TuioTime constructor does,
+		 * but keeps the storage of its TuioPath.
+		 *
+		 * @param	ttime	the TuioTime to assign
+		 * @param	si	the Session ID to assign
+		 * @param	xp	the X coordinate to assign
+		 * @param	yp	the Y coordinate to assign
+		 */
+		void reset(TuioTime ttime, long si, float xp, float yp, float zp=0) {
+			xpos = xp;
+			ypos = yp;
+			zpos = zp;
+			currentTime = ttime;
+			startTime = currentTime;
+			
+			session_id = si;
+			x_speed = 0.0f;
+			y_speed = 0.0f;
+			z_speed = 0.0f;
+			motion_speed = 0.0f;
+			motion_accel = 0.0f;
+			TuioPoint p(currentTime,xpos,ypos,zpos);
+			path.reset();
+			path.add(p);
+			
+			state = TUIO_ADDED;
+			slot_handle = TUIO_INVALID_SLOT;
+		};
+
 	public:
 		/**
 		 * This constructor takes a TuioTime argument and assigns it along with the provided 
@@ -95,9 +131,10 @@ namespace TUIO {
 			motion_speed = 0.0f;
 			motion_accel = 0.0f;			
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			state = TUIO_ADDED;
+			slot_handle = TUIO_INVALID_SLOT;
 		};
 
 		/**
@@ -116,9 +153,10 @@ namespace TUIO {
 			motion_speed = 0.0f;
 			motion_accel = 0.0f;			
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			state = TUIO_ADDED;
+			slot_handle = TUIO_INVALID_SLOT;
 		};
 		
 		/**
@@ -135,9 +173,10 @@ namespace TUIO {
 			motion_speed = 0.0f;
 			motion_accel = 0.0f;
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			state = TUIO_ADDED;
+			slot_handle = TUIO_INVALID_SLOT;
 		};
 		
 		/**
@@ -155,25 +194,28 @@ namespace TUIO {
 		 * @param	yp	the Y coordinate to assign
 		 */
 		virtual void update (TuioTime ttime, float xp, float yp, float zp = 0) {
-			TuioPoint lastPoint = path.back();
+			TuioPoint lastPoint(currentTime,xpos,ypos,zpos);
 			TuioPoint::update(ttime,xp, yp, zp);
 			
 			TuioTime diffTime = currentTime - lastPoint.getTuioTime();
-			float dt = diffTime.getTotalMilliseconds()/1000.0f;
+			float dt = (float)diffTime.getTotalSeconds();
 			float dx = xpos - lastPoint.getX();
 			float dy = ypos - lastPoint.getY();
 			float dz = zpos - lastPoint.getZ();
 			float dist = sqrt(dx*dx+dy*dy+dz*dz);
 			float last_motion_speed = motion_speed;
 			
-			x_speed = dx/dt;
-			y_speed = dy/dt;
-			z_speed = dz/dt;
-			motion_speed = dist/dt;
-			motion_accel = (motion_speed - last_motion_speed)/dt;
+			// keep the previous speed and acceleration for repeated time stamps
+			if (dt>0) {
+				x_speed = dx/dt;
+				y_speed = dy/dt;
+				z_speed = dz/dt;
+				motion_speed = dist/dt;
+				motion_accel = (motion_speed - last_motion_speed)/dt;
+			}
 			
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -209,7 +251,7 @@ namespace TUIO {
 			motion_accel = ma;
 			
 			TuioPoint p(currentTime,xpos,ypos);
-			path.push_back(p);
+			path.add(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -224,7 +266,7 @@ namespace TUIO {
 			motion_accel = ma;
 			
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -248,9 +290,8 @@ namespace TUIO {
 			motion_speed = (float)sqrt(x_speed*x_speed+y_speed*y_speed);
 			motion_accel = ma;
 			
-			path.pop_back();
 			TuioPoint p(currentTime,xpos,ypos);
-			path.push_back(p);
+			path.replaceLast(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -264,9 +305,8 @@ namespace TUIO {
 			motion_speed = (float)sqrt(x_speed*x_speed+y_speed*y_speed+z_speed*z_speed);
 			motion_accel = ma;
 			
-			path.pop_back();
 			TuioPoint p(currentTime,xpos,ypos,zpos);
-			path.push_back(p);
+			path.replaceLast(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -289,7 +329,7 @@ namespace TUIO {
 			motion_accel = tcon->getMotionAccel();
 			
 			TuioPoint p(tcon->getTuioTime(),xpos,ypos,zpos);
-			path.push_back(p);
+			path.add(p);
 			
 			if (motion_accel>0) state = TUIO_ACCELERATING;
 			else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -353,9 +393,52 @@ namespace TUIO {
 		 * @return	the path of this TuioContainer
 		 */
 		virtual std::list<TuioPoint> getPath() {
+			std::list<TuioPoint> points;
+			for (int i=0;i<path.size();i++) points.push_back(path[i]);
+			return points;
+		};
+
+		/**
+		 * Returns a reference to the bounded path of this TuioContainer without copying it.
+		 * @return	the bounded path of this TuioContainer
+		 */
+		const TuioPath& getTuioPath() const {
 			return path;
 		};
+
+		/**
+		 * Changes the maximum number of previous positions kept in the path of this TuioContainer.
+		 *
+		 * @param	length	the maximum path length, zero disables the path history
+		 */
+		void setPathLength(int length) {
+			path.setCapacity(length);
+		};
+
+		/**
+		 * Returns the maximum number of previous positions kept in the path of this TuioContainer.
+		 * @return	the maximum path length of this TuioContainer
+		 */
+		int getPathLength() const {
+			return path.getCapacity();
+		};
 		
+		/**
+		 * Returns the TuioSlotMap handle of this TuioContainer.
+		 * @return	the TuioSlotMap handle of this TuioContainer
+		 */
+		unsigned long long getSlotHandle() {
+			return slot_handle;
+		};
+
+		/**
+		 * Assigns the TuioSlotMap handle of this TuioContainer.
+		 * @param	handle	the TuioSlotMap handle to assign
+		 */
+		void setSlotHandle(unsigned long long handle) {
+			slot_handle = handle;
+		};
+
 		/**
 		 * Returns the motion speed of this TuioContainer.
 		 * @return	the motion speed of this TuioContainer
@@ -27,6 +27,19 @@
 
 namespace TUIO {
 	
+	/**
+	 * The TuioCursorState structure is a plain copy of the TuioCursor attributes, which are encoded
+	 * into a /tuio/2Dcur or /tuio/3Dcur set message. It allows the TuioServer to serialize its cursors
+	 * from a contiguous array without any virtual method calls.
+	 */
+	struct TuioCursorState {
+		long session_id;
+		int cursor_id;
+		float xpos, ypos, zpos;
+		float x_speed, y_speed, z_speed;
+		float motion_accel;
+	};
+	
 	/**
 	 * The TuioCursor class encapsulates /tuio/2Dcur TUIO cursors.
 	 *
@@ -40,6 +53,10 @@ namespace TUIO {
 		 * The individual cursor ID number that is assigned to each TuioCursor.
 		 */ 
 		int cursor_id;
+		/**
+		 * The attributes of this TuioCursor which have been sent most recently by its TuioServer.
+		 */
+		TuioCursorState sent_state;
 		
 	public:
 		/**
@@ -54,6 +71,7 @@ namespace TUIO {
 		 */
 		TuioCursor (TuioTime ttime, long si, int ci, float xp, float yp, float zp=0):TuioContainer(ttime,si,xp,yp,zp) {
 			cursor_id = ci;
+			sent_state.session_id = -1;
 		};
 
 		/**
@@ -67,6 +85,7 @@ namespace TUIO {
 		 */
 		TuioCursor (long si, int ci, float xp, float yp, float zp=0):TuioContainer(si,xp,yp,zp) {
 			cursor_id = ci;
+			sent_state.session_id = -1;
 		};
 		
 		/**
@@ -77,6 +96,24 @@ namespace TUIO {
 		 */
 		TuioCursor (TuioCursor *tcur):TuioContainer(tcur) {
 			cursor_id = tcur->getCursorID();
+			sent_state.session_id = -1;
+		};
+		
+		/**
+		 * Reinitializes this TuioCursor with the provided TuioTime, Session ID, Cursor ID, X and Y coordinate
+		 * like the corresponding constructor, keeping the storage of its path. This allows the TuioServer
+		 * to reuse removed TuioCursors without any heap allocations.
+		 *
+		 * @param	ttime	the TuioTime to assign
+		 * @param	si	the Session ID  to assign
+		 * @param	ci	the Cursor ID  to assign
+		 * @param	xp	the X coordinate to assign
+		 * @param	yp	the Y coordinate to assign
+		 */
+		void reset (TuioTime ttime, long si, int ci, float xp, float yp, float zp=0) {
+			TuioContainer::reset(ttime,si,xp,yp,zp);
+			cursor_id = ci;
+			sent_state.session_id = -1;
 		};
 		
 		/**
@@ -91,6 +128,52 @@ namespace TUIO {
 		int getCursorID() {
 			return cursor_id;
 		};
+		
+		/**
+		 * Copies the current attributes of this TuioCursor into the provided TuioCursorState.
+		 * This method is not virtual and can be inlined, overridden accessors are not taken into account.
+		 *
+		 * @param	tstate	the TuioCursorState to assign
+		 */
+		void getState(TuioCursorState &tstate) const {
+			tstate.session_id = session_id;
+			tstate.cursor_id = cursor_id;
+			tstate.xpos = xpos;
+			tstate.ypos = ypos;
+			tstate.zpos = zpos;
+			tstate.x_speed = x_speed;
+			tstate.y_speed = y_speed;
+			tstate.z_speed = z_speed;
+			tstate.motion_accel = motion_accel;
+		};
+
+		/**
+		 * Returns true if any attribute of the provided TuioCursorState differs by more than the provided epsilon
+		 * from the TuioCursorState which has been sent most recently, or if no TuioCursorState has been sent yet.
+		 *
+		 * @param	tstate	the current TuioCursorState
+		 * @param	epsilon	the largest difference which is considered unchanged
+		 * @return	true if the TuioCursorState needs to be sent
+		 */
+		bool differsFromSentState(const TuioCursorState &tstate, float epsilon) const {
+			if (sent_state.session_id!=tstate.session_id) return true;
+			float deltas[7] = { tstate.xpos-sent_state.xpos, tstate.ypos-sent_state.ypos, tstate.zpos-sent_state.zpos,
+				tstate.x_speed-sent_state.x_speed, tstate.y_speed-sent_state.y_speed, tstate.z_speed-sent_state.z_speed,
+				tstate.motion_accel-sent_state.motion_accel };
+			for (int i=0;i<7;i++) {
+				if ((deltas[i]>epsilon) || (deltas[i]<-epsilon)) return true;
+			}
+			return false;
+		};
+
+		/**
+		 * Remembers the provided TuioCursorState as the one which has been sent most recently.
+		 *
+		 * @param	tstate	the sent TuioCursorState
+		 */
+		void setSentState(const TuioCursorState &tstate) {
+			sent_state = tstate;
+		};
 	};
 };
 #endif
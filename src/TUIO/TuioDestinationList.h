@@ -0,0 +1,202 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIODESTINATIONLIST_H
+#define INCLUDED_TUIODESTINATIONLIST_H
+
+#ifndef WIN32
+#include <pthread.h>
+#else
+#include <windows.h>
+#endif
+
+#include <vector>
+#include "ip/NetworkingUtils.h"
+#include "ip/UdpSocket.h"
+
+namespace TUIO {
+
+	/**
+	 * The TuioDestination structure holds the endpoint of a TUIO receiver
+	 * along with the number of datagrams and bytes which have been sent to it.
+	 */
+	struct TuioDestination {
+		IpEndpointName endpoint;
+		long datagrams;
+		long bytes;
+		long failures;
+	};
+
+	/**
+	 * The TuioDestinationList class sends the serialized packets of a TUIO frame to any number of
+	 * unicast, broadcast or multicast destinations through a single unconnected UdpSocket,
+	 * so each frame is serialized only once regardless of the number of receivers.
+	 * Destinations can be added and removed at runtime from any thread.
+	 *
+	 * @version 1.4
+	 */
+	class TuioDestinationList {
+
+	private:
+		UdpSocket *socket;
+		std::vector<TuioDestination> destinations;
+
+#ifndef WIN32
+		pthread_mutex_t destinationMutex;
+#else
+		HANDLE destinationMutex;
+#endif
+
+		void lock() {
+#ifndef WIN32
+			pthread_mutex_lock(&destinationMutex);
+#else
+			WaitForSingleObject(destinationMutex, INFINITE);
+#endif
+		}
+
+		void unlock() {
+#ifndef WIN32
+			pthread_mutex_unlock(&destinationMutex);
+#else
+			ReleaseMutex(destinationMutex);
+#endif
+		}
+
+		int find(const IpEndpointName &endpoint) {
+			for (unsigned int i=0;i<destinations.size();i++)
+				if (destinations[i].endpoint==endpoint) return i;
+			return -1;
+		}
+
+		TuioDestinationList(const TuioDestinationList&);
+		TuioDestinationList& operator=(const TuioDestinationList&);
+
+	public:
+		/**
+		 * This constructor creates an empty TuioDestinationList sending with the provided socket.
+		 *
+		 * @param	sock	the unconnected UdpSocket to send the packets with
+		 */
+		TuioDestinationList(UdpSocket *sock):socket(sock) {
+#ifndef WIN32
+			pthread_mutex_init(&destinationMutex,NULL);
+#else
+			destinationMutex = CreateMutex(NULL,FALSE,NULL);
+#endif
+		};
+
+		/**
+		 * The destructor releases the mutex, the socket is not deleted.
+		 */
+		~TuioDestinationList() {
+#ifndef WIN32
+			pthread_mutex_destroy(&destinationMutex);
+#else
+			CloseHandle(destinationMutex);
+#endif
+		};
+
+		/**
+		 * Adds the provided host and port to the list of destinations.
+		 *
+		 * @param	host	the receiving host name or unicast, broadcast or multicast address
+		 * @param	port	the receiving UDP port number
+		 * @return	false if the destination already is in the list
+		 */
+		bool add(const char *host, int port) {
+			TuioDestination destination;
+			destination.endpoint = IpEndpointName(GetHostByName(host),port);
+			destination.datagrams = destination.bytes = destination.failures = 0;
+
+			lock();
+			bool added = (find(destination.endpoint)<0);
+			if (added) destinations.push_back(destination);
+			unlock();
+			return added;
+		};
+
+		/**
+		 * Removes the provided host and port from the list of destinations.
+		 *
+		 * @param	host	the receiving host name or address
+		 * @param	port	the receiving UDP port number
+		 * @return	false if the destination was not in the list
+		 */
+		bool remove(const char *host, int port) {
+			IpEndpointName endpoint(GetHostByName(host),port);
+
+			lock();
+			int index = find(endpoint);
+			if (index>=0) destinations.erase(destinations.begin()+index);
+			unlock();
+			return (index>=0);
+		};
+
+		/**
+		 * Returns the number of destinations.
+		 * @return	the number of destinations
+		 */
+		int size() {
+			lock();
+			int count = (int)destinations.size();
+			unlock();
+			return count;
+		};
+
+		/**
+		 * Returns a copy of the destination at the provided position including its send statistics.
+		 *
+		 * @param	index	the position within 0..size()-1
+		 * @param	destination	the TuioDestination to fill
+		 * @return	false if there is no destination at the provided position
+		 */
+		bool get(int index, TuioDestination &destination) {
+			lock();
+			bool found = (index>=0) && (index<(int)destinations.size());
+			if (found) destination = destinations[index];
+			unlock();
+			return found;
+		};
+
+		/**
+		 * Sends the provided packets to all destinations and updates their send statistics.
+		 *
+		 * @param	data	the packet data
+		 * @param	sizes	the packet sizes
+		 * @param	count	the number of packets
+		 */
+		void send(const char * const *data, const int *sizes, int count) {
+			if (socket==NULL) return;
+
+			lock();
+			for (unsigned int i=0;i<destinations.size();i++) {
+				TuioDestination &destination = destinations[i];
+				int sent = socket->SendBatchTo(destination.endpoint,data,sizes,count);
+				destination.datagrams += sent;
+				destination.failures += count-sent;
+				for (int j=0;j<sent;j++) destination.bytes += sizes[j];
+			}
+			unlock();
+		};
+	};
+};
+#endif /* INCLUDED_TUIODESTINATIONLIST_H */
@@ -0,0 +1,129 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOFRAMELISTENER_H
+#define INCLUDED_TUIOFRAMELISTENER_H
+
+#include "TuioListener.h"
+
+namespace TUIO {
+
+	/**
+	 * The TuioCursorFrame structure holds all TuioCursors which have been added, updated or removed
+	 * within a single TUIO frame. The arrays and the removed TuioCursors are only valid during the callback.
+	 */
+	struct TuioCursorFrame {
+		TuioTime frameTime;
+		long frameID;
+		TuioCursor * const *added;
+		int addedCount;
+		TuioCursor * const *updated;
+		int updatedCount;
+		TuioCursor * const *removed;
+		int removedCount;
+	};
+
+	/**
+	 * The TuioObjectFrame structure holds all TuioObjects which have been added, updated or removed
+	 * within a single TUIO frame. The arrays and the removed TuioObjects are only valid during the callback.
+	 */
+	struct TuioObjectFrame {
+		TuioTime frameTime;
+		long frameID;
+		TuioObject * const *added;
+		int addedCount;
+		TuioObject * const *updated;
+		int updatedCount;
+		TuioObject * const *removed;
+		int removedCount;
+	};
+
+	/**
+	 * The TuioFrameListener interface is used by the {@link TuioClient} to dispatch all changes of a TUIO frame
+	 * with a single callback, which is invoked once per received cursor or object frame even if nothing has changed.
+	 *
+	 * @version 1.4
+	 */
+	class TuioFrameListener {
+
+	public:
+		/**
+		 * The destructor is doing nothing in particular.
+		 */
+		virtual ~TuioFrameListener(){};
+
+		/**
+		 * This callback method is invoked by the TuioClient after each received TuioObject frame.
+		 *
+		 * @param  frame  the added, updated and removed TuioObjects of the frame
+		 */
+		virtual void objectFrame(const TuioObjectFrame &frame)=0;
+
+		/**
+		 * This callback method is invoked by the TuioClient after each received TuioCursor frame.
+		 *
+		 * @param  frame  the added, updated and removed TuioCursors of the frame
+		 */
+		virtual void cursorFrame(const TuioCursorFrame &frame)=0;
+	};
+
+	/**
+	 * The TuioListenerAdapter class dispatches the frames received as a TuioFrameListener
+	 * to the individual callbacks of a TuioListener, removals first, followed by additions,
+	 * updates and the final refresh.
+	 *
+	 * @version 1.4
+	 */
+	class TuioListenerAdapter : public TuioFrameListener {
+
+	private:
+		TuioListener *listener;
+
+	public:
+		/**
+		 * This constructor creates a TuioListenerAdapter for the provided TuioListener.
+		 *
+		 * @param  tlistener  the TuioListener to dispatch to
+		 */
+		TuioListenerAdapter(TuioListener *tlistener):listener(tlistener) {};
+
+		/**
+		 * Returns the TuioListener this TuioListenerAdapter dispatches to.
+		 * @return  the TuioListener
+		 */
+		TuioListener* getListener() { return listener; }
+
+		void objectFrame(const TuioObjectFrame &frame) {
+			for (int i=0;i<frame.removedCount;i++) listener->removeTuioObject(frame.removed[i]);
+			for (int i=0;i<frame.addedCount;i++) listener->addTuioObject(frame.added[i]);
+			for (int i=0;i<frame.updatedCount;i++) listener->updateTuioObject(frame.updated[i]);
+			listener->refresh(frame.frameTime);
+		};
+
+		void cursorFrame(const TuioCursorFrame &frame) {
+			for (int i=0;i<frame.removedCount;i++) listener->removeTuioCursor(frame.removed[i]);
+			for (int i=0;i<frame.addedCount;i++) listener->addTuioCursor(frame.added[i]);
+			for (int i=0;i<frame.updatedCount;i++) listener->updateTuioCursor(frame.updated[i]);
+			listener->refresh(frame.frameTime);
+		};
+	};
+};
+#endif /* INCLUDED_TUIOFRAMELISTENER_H */
@@ -0,0 +1,219 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOIDALLOCATOR_H
+#define INCLUDED_TUIOIDALLOCATOR_H
+
+#include <vector>
+
+namespace TUIO {
+
+	/**
+	 * The TuioIdAllocator class hands out the compact Cursor IDs used by the TuioServer and the TuioClient.
+	 * A released ID below the current maximum ID is kept free along with the last position of its cursor,
+	 * and is handed out again before the maximum ID grows. Once the maximum ID is released, all free IDs
+	 * above the new maximum are dropped. Free IDs are tracked in a bitset for the lowest free ID lookup
+	 * and in a dense array for the closest free ID lookup, so apart from growing beyond the reserved
+	 * capacity neither allocation nor release allocate any memory. A second bitset marks the bitset
+	 * words holding any free ID, so the lowest free ID among the first 1024 IDs is found with two bit scans.
+	 *
+	 * @version 1.4
+	 */
+	class TuioIdAllocator {
+
+	private:
+		struct Slot {
+			float x, y, z;
+			int freeIndex;
+		};
+
+		std::vector<Slot> slots;
+		std::vector<unsigned int> freeBits;
+		std::vector<unsigned int> freeWords;
+		std::vector<int> freeIDs;
+		int firstWord;	// all freeWords below are empty
+		int maxID;
+
+		static int lowestBit(unsigned int word) {
+#if defined(__GNUC__)
+			return __builtin_ctz(word);
+#else
+			int bit = 0;
+			while (!(word & 1)) { word >>= 1; bit++; }
+			return bit;
+#endif
+		}
+
+		void grow(int id) {
+			if (id<(int)slots.size()) return;
+			Slot s;
+			s.x = s.y = s.z = 0.0f;
+			s.freeIndex = -1;
+			slots.resize(id+1,s);
+			freeBits.resize((id>>5)+1,0);
+			freeWords.resize((id>>10)+1,0);
+		}
+
+		void markFree(int id) {
+			slots[id].freeIndex = (int)freeIDs.size();
+			freeIDs.push_back(id);
+			freeBits[id>>5] |= (1u<<(id&31));
+			freeWords[id>>10] |= (1u<<((id>>5)&31));
+			if ((id>>10)<firstWord) firstWord = id>>10;
+		}
+
+		void unmarkFree(int id) {
+			int index = slots[id].freeIndex;
+			int last = freeIDs.back();
+			freeIDs[index] = last;
+			slots[last].freeIndex = index;
+			freeIDs.pop_back();
+			slots[id].freeIndex = -1;
+			freeBits[id>>5] &= ~(1u<<(id&31));
+			if (freeBits[id>>5]==0) freeWords[id>>10] &= ~(1u<<((id>>5)&31));
+		}
+
+		int take(int id) {
+			if (id>=0) unmarkFree(id);
+			else {
+				id = ++maxID;
+				grow(id);
+			}
+			return id;
+		}
+
+	public:
+		/**
+		 * The default constructor creates an empty TuioIdAllocator.
+		 */
+		TuioIdAllocator():firstWord(0),maxID(-1) {};
+
+		/**
+		 * Makes sure that the provided number of IDs can be handed out without any further heap allocations.
+		 *
+		 * @param	count	the number of IDs to reserve space for
+		 */
+		void reserve(int count) {
+			slots.reserve(count);
+			freeBits.reserve((count>>5)+1);
+			freeWords.reserve((count>>10)+1);
+			freeIDs.reserve(count);
+		};
+
+		/**
+		 * Returns the lowest free ID, or a new maximum ID if there are no free IDs.
+		 * This takes constant time while the IDs stay below 1024, beyond that one more word is checked per 1024 IDs.
+		 *
+		 * @return	the allocated ID
+		 */
+		int allocate() {
+			int id = -1;
+			while ((firstWord<(int)freeWords.size()) && (freeWords[firstWord]==0)) firstWord++;
+			if (firstWord<(int)freeWords.size()) {
+				int word = (firstWord<<5) + lowestBit(freeWords[firstWord]);
+				id = (word<<5) + lowestBit(freeBits[word]);
+			}
+			return take(id);
+		};
+
+		/**
+		 * Returns the free ID which was released closest to the provided position,
+		 * or a new maximum ID if there are no free IDs.
+		 * There is no spatial index, so this takes time linear in the number of free IDs (see getFreeCount()),
+		 * which are only the gaps below the highest ID in use.
+		 *
+		 * @param	xp	the X coordinate of the new cursor
+		 * @param	yp	the Y coordinate of the new cursor
+		 * @param	zp	the Z coordinate of the new cursor
+		 * @return	the allocated ID
+		 */
+		int allocate(float xp, float yp, float zp = 0) {
+			int id = -1;
+			float closest = 0.0f;
+			for (unsigned int i=0;i<freeIDs.size();i++) {
+				const Slot &s = slots[freeIDs[i]];
+				float dx = s.x-xp;
+				float dy = s.y-yp;
+				float dz = s.z-zp;
+				float distance = dx*dx+dy*dy+dz*dz;
+				if ((id<0) || (distance<closest)) {
+					id = freeIDs[i];
+					closest = distance;
+				}
+			}
+			return take(id);
+		};
+
+		/**
+		 * Releases the provided ID and remembers the last position of its cursor.
+		 *
+		 * @param	id	the ID to release
+		 * @param	xp	the last X coordinate of the cursor
+		 * @param	yp	the last Y coordinate of the cursor
+		 * @param	zp	the last Z coordinate of the cursor
+		 */
+		void release(int id, float xp = 0, float yp = 0, float zp = 0) {
+			if ((id<0) || (id>maxID) || (slots[id].freeIndex>=0)) return;
+
+			if (id==maxID) {
+				maxID--;
+				while ((maxID>=0) && (slots[maxID].freeIndex>=0)) {
+					unmarkFree(maxID);
+					maxID--;
+				}
+			} else {
+				slots[id].x = xp;
+				slots[id].y = yp;
+				slots[id].z = zp;
+				markFree(id);
+			}
+		};
+
+		/**
+		 * Releases all IDs.
+		 */
+		void clear() {
+			for (unsigned int i=0;i<freeIDs.size();i++) slots[freeIDs[i]].freeIndex = -1;
+			freeIDs.clear();
+			for (unsigned int i=0;i<freeBits.size();i++) freeBits[i] = 0;
+			for (unsigned int i=0;i<freeWords.size();i++) freeWords[i] = 0;
+			firstWord = 0;
+			maxID = -1;
+		};
+
+		/**
+		 * Returns the highest ID currently in use, or -1 if no ID is in use.
+		 * @return	the highest ID currently in use
+		 */
+		int getMaxID() const {
+			return maxID;
+		};
+
+		/**
+		 * Returns the number of free IDs below the highest ID currently in use.
+		 * @return	the number of free IDs
+		 */
+		int getFreeCount() const {
+			return (int)freeIDs.size();
+		};
+	};
+};
+#endif /* INCLUDED_TUIOIDALLOCATOR_H */
@@ -0,0 +1,165 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioJitterBuffer.h"
+
+using namespace TUIO;
+
+TuioJitterBuffer::TuioJitterBuffer(int ms)
+: started       (false)
+, released      (0)
+, newest        (0)
+, referenceFrame(0)
+, referenceTime (0)
+, lastArrival   (0)
+, elapsedTime   (0)
+, elapsedFrames (0)
+, frameInterval (0)
+, delay         (ms)
+{
+	stats.received = 0;
+	stats.reordered = 0;
+	stats.late = 0;
+	stats.lost = 0;
+	stats.interpolated = 0;
+	stats.overflows = 0;
+	stats.frameInterval = 0;
+	reset();
+}
+
+void TuioJitterBuffer::reset() {
+	for (int i=0;i<TUIO_JITTER_FRAMES;i++) frames[i].fseq = -1;
+	started = false;
+}
+
+void TuioJitterBuffer::clear() {
+	reset();
+}
+
+double TuioJitterBuffer::releaseTime(long fseq) const {
+	return referenceTime + (fseq-referenceFrame)*frameInterval + delay;
+}
+
+bool TuioJitterBuffer::insert(long fseq, long now, const std::vector<TuioCursorState> &cursors, const std::vector<long> *alive) {
+	stats.received++;
+
+	if ((started) && (fseq<=released) && ((released-fseq)>TUIO_JITTER_RESTART)) reset();
+	if ((started) && (fseq>newest) && ((fseq-newest)>TUIO_JITTER_RESTART)) reset();
+	if (!started) {
+		started = true;
+		released = newest = fseq-1;
+		referenceFrame = fseq;
+		referenceTime = lastArrival = now;
+	}
+
+	if (fseq<=released) {
+		stats.late++;
+		return false;
+	}
+
+	// the fseq ran too far ahead, so the frames which would be overwritten are dropped
+	if ((fseq-released)>TUIO_JITTER_FRAMES) {
+		long first = fseq-TUIO_JITTER_FRAMES;
+		long dropped = 0;
+		for (int i=0;i<TUIO_JITTER_FRAMES;i++) {
+			if ((frames[i].fseq>released) && (frames[i].fseq<=first)) {
+				frames[i].fseq = -1;
+				dropped++;
+			}
+		}
+		stats.overflows += dropped;
+		stats.lost += (first-released)-dropped;
+		released = first;
+	}
+
+	Frame &buffered = frame(fseq);
+	if (buffered.fseq==fseq) {
+		// another packet of a frame which has been split by the sender
+		buffered.cursors.insert(buffered.cursors.end(),cursors.begin(),cursors.end());
+		if (alive!=NULL) {
+			buffered.alive.assign(alive->begin(),alive->end());
+			buffered.hasAlive = true;
+		}
+		return true;
+	}
+	buffered.fseq = fseq;
+	buffered.cursors.assign(cursors.begin(),cursors.end());
+	buffered.hasAlive = (alive!=NULL);
+	if (alive!=NULL) buffered.alive.assign(alive->begin(),alive->end());
+
+	if (fseq>newest) {
+		if (newest>=referenceFrame) {
+			// bursts are averaged out by accumulating the elapsed time and frames separately
+			elapsedTime += (now-lastArrival) - elapsedTime/TUIO_JITTER_SMOOTHING;
+			elapsedFrames += (fseq-newest) - elapsedFrames/TUIO_JITTER_SMOOTHING;
+			frameInterval = elapsedTime/elapsedFrames;
+
+			// the release clock follows earlier arrivals at once and later arrivals slowly
+			double expected = referenceTime + (fseq-referenceFrame)*frameInterval;
+			if (now<expected) referenceTime = now;
+			else referenceTime = expected + (now-expected)/TUIO_JITTER_SMOOTHING;
+			referenceFrame = fseq;
+		}
+		newest = fseq;
+		lastArrival = now;
+	} else stats.reordered++;
+
+	stats.frameInterval = (float)frameInterval;
+	return true;
+}
+
+int TuioJitterBuffer::next(long now, long &fseq, std::vector<TuioCursorState> &cursors, std::vector<long> &alive, bool &hasAlive, float &weight) {
+	if (!started) return TUIO_JITTER_NONE;
+
+	for (;;) {
+		long head = released+1;
+		while ((head<=newest) && (frame(head).fseq!=head)) head++;
+		if (head>newest) return TUIO_JITTER_NONE;
+
+		long due = released+1;
+		if (now<releaseTime(due)) return TUIO_JITTER_NONE;
+
+		Frame &buffered = frame(head);
+		if (head==due) {
+			cursors.assign(buffered.cursors.begin(),buffered.cursors.end());
+			hasAlive = buffered.hasAlive;
+			if (hasAlive) alive.assign(buffered.alive.begin(),buffered.alive.end());
+			buffered.fseq = -1;
+			released = fseq = head;
+			return TUIO_JITTER_FRAME;
+		}
+
+		// longer gaps are skipped, the next buffered frame is released on its own time
+		if ((head-due)>TUIO_JITTER_INTERPOLATE) {
+			stats.lost += head-due;
+			released = head-1;
+			continue;
+		}
+
+		cursors.assign(buffered.cursors.begin(),buffered.cursors.end());
+		hasAlive = false;
+		weight = 1.0f/(head-due+1);
+		released = fseq = due;
+		stats.lost++;
+		stats.interpolated++;
+		return TUIO_JITTER_MISSING;
+	}
+}
@@ -0,0 +1,159 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOJITTERBUFFER_H
+#define INCLUDED_TUIOJITTERBUFFER_H
+
+#include <vector>
+#include "TuioCursor.h"
+
+#define TUIO_JITTER_FRAMES 32		// number of buffered frames, needs to be a power of two
+#define TUIO_JITTER_DELAY 30		// default target delay in milliseconds
+#define TUIO_JITTER_TICK 2			// milliseconds between the checks for due frames
+#define TUIO_JITTER_INTERPOLATE 4	// maximum number of consecutive missing frames which are interpolated
+#define TUIO_JITTER_SMOOTHING 16	// number of frames the estimated frame interval and release clock are averaged over
+#define TUIO_JITTER_RESTART 100		// frames an fseq may step back or jump ahead before it is considered a restarted sender
+
+#define TUIO_JITTER_NONE 0
+#define TUIO_JITTER_FRAME 1
+#define TUIO_JITTER_MISSING 2
+
+namespace TUIO {
+
+	/**
+	 * The TuioJitterStats structure holds the statistics of a TuioJitterBuffer.
+	 */
+	struct TuioJitterStats {
+		long received;		// frames passed to the buffer
+		long reordered;		// frames which arrived after a frame with a higher fseq
+		long late;			// packets which arrived after their frame has been released and were dropped
+		long lost;			// frames which have not arrived until their release time, including frames the sender has skipped
+		long interpolated;	// lost frames which have been replaced by an interpolated frame
+		long overflows;		// buffered frames which have been dropped since the fseq ran too far ahead
+		float frameInterval;	// the estimated interval between two frames of the sender in milliseconds
+	};
+
+	/**
+	 * The TuioJitterBuffer class reorders received TuioCursor frames by their fseq and releases them on a steady clock.
+	 * The interval between two frames of the sender is estimated from the arrival times of the frames, which
+	 * anchor a release clock following the earliest arrivals. Each frame is released the target delay after
+	 * its expected arrival time, so frames arriving within the delay are released in order and evenly spaced.
+	 * A frame which has not arrived until its release time is reported as missing together with the next
+	 * buffered frame, so the receiver can interpolate between the current state and that frame.
+	 * A frame which has been split into several packets is collected from all packets carrying its fseq
+	 * until the frame is released.
+	 * The buffered frames are kept in a ring indexed by fseq, which does not allocate any memory once the
+	 * frames have reached their usual size.
+	 *
+	 * @version 1.4
+	 */
+	class TuioJitterBuffer {
+
+	private:
+		struct Frame {
+			long fseq;
+			std::vector<TuioCursorState> cursors;
+			std::vector<long> alive;
+			bool hasAlive;
+		};
+
+		Frame frames[TUIO_JITTER_FRAMES];
+		bool started;
+		long released;
+		long newest;
+		long referenceFrame;
+		double referenceTime;
+		double lastArrival;
+		double elapsedTime;
+		double elapsedFrames;
+		double frameInterval;
+		int delay;
+		TuioJitterStats stats;
+
+		Frame& frame(long fseq) { return frames[fseq & (TUIO_JITTER_FRAMES-1)]; }
+		double releaseTime(long fseq) const;
+		void reset();
+
+		TuioJitterBuffer(const TuioJitterBuffer&);
+		TuioJitterBuffer& operator=(const TuioJitterBuffer&);
+
+	public:
+		/**
+		 * This constructor creates an empty TuioJitterBuffer with the provided target delay.
+		 *
+		 * @param	ms	the target delay in milliseconds
+		 */
+		TuioJitterBuffer(int ms = TUIO_JITTER_DELAY);
+
+		/**
+		 * Sets the target delay.
+		 *
+		 * @param	ms	the target delay in milliseconds
+		 */
+		void setDelay(int ms) { delay = ms; }
+
+		/**
+		 * Returns the target delay.
+		 * @return	the target delay in milliseconds
+		 */
+		int getDelay() const { return delay; }
+
+		/**
+		 * Buffers a copy of the provided frame unless it is late. If the frame has already been buffered from
+		 * another packet, the provided TuioCursors are appended to it, and the alive list is replaced if provided.
+		 *
+		 * @param	fseq	the positive fseq of the frame
+		 * @param	now	the arrival time in milliseconds
+		 * @param	cursors	the states of the TuioCursors set within the packet
+		 * @param	alive	the Session IDs of all alive TuioCursors, or NULL if the packet carried no alive message
+		 * @return	true if the packet has been buffered
+		 */
+		bool insert(long fseq, long now, const std::vector<TuioCursorState> &cursors, const std::vector<long> *alive);
+
+		/**
+		 * Releases the next frame if its release time has passed. Returns TUIO_JITTER_FRAME together
+		 * with the released frame, or TUIO_JITTER_MISSING if the released frame has been lost, together with
+		 * the states of the next buffered frame and the weight they should be interpolated with.
+		 * Otherwise TUIO_JITTER_NONE is returned and the provided vectors remain unchanged.
+		 *
+		 * @param	now	the current time in milliseconds
+		 * @param	fseq	returns the fseq of the released frame
+		 * @param	cursors	returns the states of the TuioCursors
+		 * @param	alive	returns the Session IDs of all alive TuioCursors if hasAlive is set
+		 * @param	hasAlive	returns false for missing frames or frames which have been received without any alive message
+		 * @param	weight	returns the weight of the provided states for missing frames
+		 * @return	TUIO_JITTER_FRAME, TUIO_JITTER_MISSING or TUIO_JITTER_NONE
+		 */
+		int next(long now, long &fseq, std::vector<TuioCursorState> &cursors, std::vector<long> &alive, bool &hasAlive, float &weight);
+
+		/**
+		 * Drops all buffered frames and restarts with the next inserted frame.
+		 */
+		void clear();
+
+		/**
+		 * Returns the statistics since the TuioJitterBuffer has been created.
+		 * @return	the statistics
+		 */
+		TuioJitterStats getStats() const { return stats; }
+	};
+};
+#endif /* INCLUDED_TUIOJITTERBUFFER_H */
@@ -0,0 +1,351 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioLog.h"
+#include <iostream>
+#include <string.h>
+#include <time.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+using namespace TUIO;
+
+#define TUIO_LOG_MASK (TUIO_LOG_CAPACITY-1)
+
+#define TUIO_LOG_IDLE 0		// the writer thread has not been started yet
+#define TUIO_LOG_STARTING 1	// the writer thread is being started
+#define TUIO_LOG_RUNNING 2	// the writer thread is running
+#define TUIO_LOG_FINISHED 3	// the writer thread has been stopped or is never going to be started
+
+#define TUIO_LOG_POLL 10	// milliseconds between the checks for new records while messages are being logged
+#define TUIO_LOG_IDLE_POLLS 100	// checks without any new records before the writer thread waits to be woken up
+
+TuioLog TuioLog::instance;
+
+namespace TUIO {
+
+	// stops the writer thread at exit, without destroying the log ring itself
+	struct TuioLogShutdown {
+		~TuioLogShutdown() { TuioLog::shutdown(); }
+	};
+};
+
+static TuioLogShutdown shutdownGuard;
+
+static long atomicLoad(volatile long *value) {
+#ifdef WIN32
+	return InterlockedCompareExchange(value, 0, 0);
+#else
+	return __sync_fetch_and_or(value, 0);
+#endif
+}
+
+static bool compareAndSwap(volatile long *value, long expected, long desired) {
+#ifdef WIN32
+	return (InterlockedCompareExchange(value, desired, expected)==expected);
+#else
+	return __sync_bool_compare_and_swap(value, expected, desired);
+#endif
+}
+
+// replaces the value, acting as a full memory barrier
+static void atomicStore(volatile long *value, long desired) {
+#ifdef WIN32
+	InterlockedExchange(value, desired);
+#else
+	long previous;
+	do {
+		previous = atomicLoad(value);
+	} while (!__sync_bool_compare_and_swap(value, previous, desired));
+#endif
+}
+
+static long atomicIncrement(volatile long *value) {
+#ifdef WIN32
+	return InterlockedIncrement(value);
+#else
+	return __sync_add_and_fetch(value, 1);
+#endif
+}
+
+static void sleepMilliseconds(int ms) {
+#ifndef WIN32
+	usleep(ms*1000);
+#else
+	Sleep(ms);
+#endif
+}
+
+#ifndef WIN32
+void* TuioLog::threadFunc( void* obj )
+#else
+DWORD WINAPI TuioLog::threadFunc( LPVOID obj )
+#endif
+{
+	static_cast<TuioLog*>(obj)->run();
+	return 0;
+};
+
+TuioLog::TuioLog()
+: head       (0)
+, tail       (0)
+, level      (TUIO_LOG_INFO)
+, rateLimit  (TUIO_LOG_RATE)
+, rateSecond (0)
+, rateCount  (0)
+, dropped    (0)
+, reported   (0)
+, started    (TUIO_LOG_IDLE)
+, stopped    (0)
+, sleeping   (0)
+, draining   (0)
+{
+	for (int i=0;i<TUIO_LOG_CAPACITY;i++) records[i].sequence = i;
+
+#ifndef WIN32
+	pthread_mutex_init(&mutex,NULL);
+	pthread_cond_init(&cond,NULL);
+#else
+	event = CreateEvent(NULL,FALSE,FALSE,NULL);
+#endif
+}
+
+// starts the writer thread unless it is already running or has been stopped
+void TuioLog::start() {
+	if ((atomicLoad(&started)!=TUIO_LOG_IDLE) || (atomicLoad(&stopped))) return;
+	if (!compareAndSwap(&started, TUIO_LOG_IDLE, TUIO_LOG_STARTING)) return;
+
+#ifndef WIN32
+	pthread_create(&thread , NULL, threadFunc, this);
+#else
+	DWORD threadId;
+	thread = CreateThread( 0, 0, threadFunc, this, 0, &threadId );
+#endif
+	atomicStore(&started, TUIO_LOG_RUNNING);
+}
+
+void TuioLog::shutdown() {
+	atomicStore(&instance.stopped, 1);
+
+	// wait until a concurrent start has completed, a thread which has never been started is not started anymore
+	for (;;) {
+		if (compareAndSwap(&instance.started, TUIO_LOG_IDLE, TUIO_LOG_FINISHED)) return;
+		if (compareAndSwap(&instance.started, TUIO_LOG_RUNNING, TUIO_LOG_FINISHED)) break;
+		if (atomicLoad(&instance.started)==TUIO_LOG_FINISHED) return;
+		sleepMilliseconds(1);
+	}
+
+	// the writer thread prints all remaining records before it returns
+	instance.wake();
+#ifndef WIN32
+	pthread_join(instance.thread, NULL);
+#else
+	WaitForSingleObject(instance.thread, INFINITE);
+	CloseHandle(instance.thread);
+#endif
+}
+
+// wakes up the writer thread if it is waiting for records, only the first caller signals it
+void TuioLog::wake() {
+	if ((!atomicLoad(&sleeping)) || (!compareAndSwap(&sleeping, 1, 0))) return;
+#ifndef WIN32
+	pthread_mutex_lock(&mutex);
+	pthread_cond_signal(&cond);
+	pthread_mutex_unlock(&mutex);
+#else
+	SetEvent(event);
+#endif
+}
+
+// waits until a record has been committed or the log has been stopped, the producers
+// check the sleeping flag after committing, so either side is going to see the other
+void TuioLog::wait() {
+#ifndef WIN32
+	pthread_mutex_lock(&mutex);
+	atomicStore(&sleeping, 1);
+	if ((!ready()) && (!atomicLoad(&stopped)) && (atomicLoad(&dropped)==reported)) pthread_cond_wait(&cond, &mutex);
+	atomicStore(&sleeping, 0);
+	pthread_mutex_unlock(&mutex);
+#else
+	atomicStore(&sleeping, 1);
+	if ((!ready()) && (!atomicLoad(&stopped)) && (atomicLoad(&dropped)==reported)) WaitForSingleObject(event, INFINITE);
+	atomicStore(&sleeping, 0);
+#endif
+}
+
+// hands a committed record or a dropped message to the writer thread,
+// or prints it right away once the writer thread has been stopped at exit
+void TuioLog::notify() {
+	if (atomicLoad(&stopped)) drain();
+	else {
+		start();
+		wake();
+	}
+}
+
+TuioLog::Record* TuioLog::claim(int lvl) {
+	if (lvl>level) return NULL;
+
+	long limit = rateLimit;
+	if (limit>0) {
+		long second = (long)time(NULL);
+		long current = atomicLoad(&rateSecond);
+		if ((second!=current) && compareAndSwap(&rateSecond, current, second)) atomicStore(&rateCount, 0);
+		if (atomicIncrement(&rateCount)>limit) {
+			atomicIncrement(&dropped);
+			notify();
+			return NULL;
+		}
+	}
+
+	// claim the record at the head position unless the writer has not consumed it yet
+	for (;;) {
+		long position = atomicLoad(&head);
+		Record *record = &records[position & TUIO_LOG_MASK];
+		long difference = atomicLoad(&record->sequence)-position;
+		if (difference==0) {
+			if (compareAndSwap(&head, position, position+1)) {
+				record->level = lvl;
+				record->label = NULL;
+				record->count = 0;
+				record->text[0] = '\0';
+				return record;
+			}
+		} else if (difference<0) {
+			atomicIncrement(&dropped);
+			notify();
+			return NULL;
+		}
+	}
+}
+
+void TuioLog::commit(Record *record) {
+	atomicStore(&record->sequence, atomicLoad(&record->sequence)+1);
+	notify();
+}
+
+void TuioLog::setLevel(int lvl) {
+	atomicStore(&instance.level, lvl);
+}
+
+void TuioLog::setRateLimit(int messages) {
+	atomicStore(&instance.rateLimit, messages);
+}
+
+// appends as much of the text as fits into the record
+void TuioLog::append(Record *record, const char *text) {
+	int length = (int)strlen(record->text);
+	strncpy(record->text+length, text, TUIO_LOG_TEXT-1-length);
+	record->text[TUIO_LOG_TEXT-1] = '\0';
+}
+
+void TuioLog::text(int lvl, const char *text, const char *detail, const char *reason) {
+	Record *record = instance.claim(lvl);
+	if (record==NULL) return;
+
+	append(record, text);
+	if (detail!=NULL) append(record, detail);
+	if (reason!=NULL) {
+		append(record, " - ");
+		append(record, reason);
+	}
+	instance.commit(record);
+}
+
+void TuioLog::values(int lvl, const char *label, long id, long session, const float *values, int count) {
+	Record *record = instance.claim(lvl);
+	if (record==NULL) return;
+
+	if (count>TUIO_LOG_VALUES) count = TUIO_LOG_VALUES;
+	record->label = label;
+	record->id = id;
+	record->session = session;
+	record->count = count;
+	for (int i=0;i<count;i++) record->values[i] = values[i];
+	instance.commit(record);
+}
+
+void TuioLog::flush() {
+	long position = atomicLoad(&instance.head);
+	while ((atomicLoad(&instance.tail)<position) && (!atomicLoad(&instance.stopped))) sleepMilliseconds(1);
+}
+
+long TuioLog::getDroppedCount() {
+	return atomicLoad(&instance.dropped);
+}
+
+// returns true if the record at the tail position is complete
+bool TuioLog::ready() {
+	long position = atomicLoad(&tail);
+	return (atomicLoad(&records[position & TUIO_LOG_MASK].sequence)==position+1);
+}
+
+// prints the record at the tail position if it is complete
+bool TuioLog::write() {
+	long position = atomicLoad(&tail);
+	Record *record = &records[position & TUIO_LOG_MASK];
+	if (atomicLoad(&record->sequence)!=position+1) return false;
+
+	std::ostream &out = (record->level<=TUIO_LOG_WARNING)?std::cerr:std::cout;
+	if (record->label!=NULL) {
+		out << record->label << " " << record->id << " (" << record->session << ")";
+		for (int i=0;i<record->count;i++) out << " " << record->values[i];
+		out << std::endl;
+	} else out << record->text << std::endl;
+
+	atomicStore(&record->sequence, position+TUIO_LOG_CAPACITY);
+	atomicStore(&tail, position+1);
+	return true;
+}
+
+// prints all complete records and reports dropped messages, unless another thread is doing so already,
+// returns true if anything has been printed
+bool TuioLog::drain() {
+	if (!compareAndSwap(&draining, 0, 1)) return false;
+	bool printed = false;
+	while (write()) printed = true;
+
+	long count = atomicLoad(&dropped);
+	if (count!=reported) {
+		std::cerr << "dropped " << (count-reported) << " log messages" << std::endl;
+		reported = count;
+		printed = true;
+	}
+	atomicStore(&draining, 0);
+	return printed;
+}
+
+void TuioLog::run() {
+	int idle = 0;
+	for (;;) {
+		bool active = (!atomicLoad(&stopped));
+		if (drain()) idle = 0;
+		else idle++;
+		if (!active) return;
+		
+		// poll while messages are being logged, since waking up the thread costs the caller a system call,
+		// and wait to be woken up by the next message once nothing has been logged for a while
+		if (idle<TUIO_LOG_IDLE_POLLS) sleepMilliseconds(TUIO_LOG_POLL);
+		else wait();
+	}
+}
@@ -0,0 +1,182 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOLOG_H
+#define INCLUDED_TUIOLOG_H
+
+#ifndef WIN32
+#include <pthread.h>
+#else
+#include <windows.h>
+#endif
+
+#define TUIO_LOG_CAPACITY 1024	// number of preallocated records, needs to be a power of two
+#define TUIO_LOG_TEXT 128	// maximum length of a text message including the terminating zero
+#define TUIO_LOG_VALUES 8	// maximum number of values of a single record
+#define TUIO_LOG_RATE 1000	// default number of messages per second
+
+#define TUIO_LOG_ERROR 0
+#define TUIO_LOG_WARNING 1
+#define TUIO_LOG_INFO 2
+#define TUIO_LOG_DEBUG 3
+
+namespace TUIO {
+
+	struct TuioLogShutdown;
+
+	/**
+	 * The TuioLog class collects log messages from any thread without blocking the caller.
+	 * Each message is stored in binary form in a preallocated ring of records, which is filled
+	 * without locks, and a background thread formats and prints the records on the console.
+	 * The background thread is started with the first message, and waits to be woken up by
+	 * the next message once nothing has been logged for a second.
+	 * At exit it prints all remaining messages, later messages are printed by the caller right away.
+	 * Messages above the configured level are skipped right away, and messages exceeding
+	 * the configured rate or the capacity of the ring are dropped and reported as such.
+	 * <p><code>
+	 * if (TuioLog::isEnabled(TUIO_LOG_INFO)) {<br/>
+	 * &nbsp;&nbsp;float values[2] = { x, y };<br/>
+	 * &nbsp;&nbsp;TuioLog::values(TUIO_LOG_INFO, "add cur", cursorID, sessionID, values, 2);<br/>
+	 * }<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	class TuioLog {
+
+		friend struct TuioLogShutdown;
+
+	private:
+		struct Record {
+			volatile long sequence;	// equals the claiming position plus one once the record is complete
+			int level;
+			const char *label;
+			long id;
+			long session;
+			int count;
+			float values[TUIO_LOG_VALUES];
+			char text[TUIO_LOG_TEXT];
+		};
+
+		Record records[TUIO_LOG_CAPACITY];
+		volatile long head;
+		volatile long tail;
+		volatile long level;
+		volatile long rateLimit;
+		volatile long rateSecond;
+		volatile long rateCount;
+		volatile long dropped;
+		long reported;	// dropped messages which have been reported, only accessed while draining
+		volatile long started;
+		volatile long stopped;
+		volatile long sleeping;
+		volatile long draining;
+
+#ifndef WIN32
+		pthread_t thread;
+		pthread_mutex_t mutex;
+		pthread_cond_t cond;
+		static void* threadFunc(void *obj);
+#else
+		HANDLE thread;
+		HANDLE event;
+		static DWORD WINAPI threadFunc(LPVOID obj);
+#endif
+
+		// the destructor is trivial, so the instance remains usable from other static destructors
+		static TuioLog instance;
+
+		TuioLog();
+		TuioLog(const TuioLog&);
+		TuioLog& operator=(const TuioLog&);
+
+		Record* claim(int level);
+		static void append(Record *record, const char *text);
+		void commit(Record *record);
+		void notify();
+		void start();
+		void wake();
+		void wait();
+		bool ready();
+		bool write();
+		bool drain();
+		void run();
+		static void shutdown();
+
+	public:
+		/**
+		 * Sets the most detailed level of messages which are going to be logged, TUIO_LOG_INFO by default.
+		 *
+		 * @param	level	one of TUIO_LOG_ERROR, TUIO_LOG_WARNING, TUIO_LOG_INFO or TUIO_LOG_DEBUG
+		 */
+		static void setLevel(int level);
+
+		/**
+		 * Returns true if messages of the provided level are going to be logged.
+		 *
+		 * @param	level	the message level
+		 * @return	true if messages of the provided level are logged
+		 */
+		static bool isEnabled(int level) { return (level<=instance.level); }
+
+		/**
+		 * Sets the number of messages which may be logged within a second, TUIO_LOG_RATE by default.
+		 *
+		 * @param	messages	the number of messages per second, or 0 for no limit
+		 */
+		static void setRateLimit(int messages);
+
+		/**
+		 * Logs a text message, which is copied and truncated to TUIO_LOG_TEXT characters.
+		 *
+		 * @param	level	the message level
+		 * @param	text	the message text
+		 * @param	detail	an optional text which is appended to the message
+		 * @param	reason	an optional text which is appended to the message after a dash
+		 */
+		static void text(int level, const char *text, const char *detail=NULL, const char *reason=NULL);
+
+		/**
+		 * Logs a label followed by an ID, a session ID and a number of values,
+		 * which are formatted by the background thread.
+		 *
+		 * @param	level	the message level
+		 * @param	label	the label, which needs to remain valid, such as a string literal
+		 * @param	id	the ID, such as a cursor or symbol ID
+		 * @param	session	the session ID
+		 * @param	values	the values
+		 * @param	count	the number of values, at most TUIO_LOG_VALUES
+		 */
+		static void values(int level, const char *label, long id, long session, const float *values, int count);
+
+		/**
+		 * Waits until all messages which have been logged so far have been printed.
+		 */
+		static void flush();
+
+		/**
+		 * Returns the number of messages which have been dropped so far.
+		 * @return	the number of dropped messages
+		 */
+		static long getDroppedCount();
+	};
+};
+#endif /* INCLUDED_TUIOLOG_H */
@@ -0,0 +1,136 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOMESSAGETEMPLATE_H
+#define INCLUDED_TUIOMESSAGETEMPLATE_H
+
+#include <string.h>
+#include "osc/OscTypes.h"
+#include "osc/OscHostEndianness.h"
+
+#define TUIO_MAX_HEADER_SIZE 64
+
+namespace TUIO {
+
+	/**
+	 * The TuioMessageTemplate class writes TUIO messages of the form <code>address command i.. f..</code>
+	 * with a fixed number of int32 and float arguments, such as <code>/tuio/2Dcur set ,siffff</code>.
+	 * The address, type tags and command string are formatted once, so writing a message only copies
+	 * the preformatted header and stores the big-endian arguments at fixed offsets.
+	 * The message is written into space reserved with OutboundPacketStream::ReserveMessage().
+	 * <p><code>
+	 * TuioMessageTemplate<1,5> cursorSet;<br/>
+	 * cursorSet.setAddress("/tuio/2Dcur","set");<br/>
+	 * cursorSet.write(packet->ReserveMessage(cursorSet.getSize()),ints,floats);<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	template<int INTS, int FLOATS> class TuioMessageTemplate {
+
+	private:
+		char header[TUIO_MAX_HEADER_SIZE];
+		int headerSize;
+
+		static int roundUp4(int size) {
+			return (size+3) & ~3;
+		}
+
+		static void putUInt32(char *p, osc::uint32 x) {
+#ifdef OSC_HOST_LITTLE_ENDIAN
+			p[0] = (char)(x>>24);
+			p[1] = (char)(x>>16);
+			p[2] = (char)(x>>8);
+			p[3] = (char)x;
+#else
+			memcpy(p,&x,4);
+#endif
+		}
+
+	public:
+		/**
+		 * The size of the arguments following the preformatted header in bytes.
+		 */
+		enum { ARGUMENT_SIZE = 4*(INTS+FLOATS) };
+
+		/**
+		 * The default constructor creates a TuioMessageTemplate without address,
+		 * setAddress() needs to be called before writing any message.
+		 */
+		TuioMessageTemplate() {
+			headerSize = 0;
+		};
+
+		/**
+		 * Preformats the address, type tags and command string of this TuioMessageTemplate.
+		 *
+		 * @param	address	the OSC address, such as /tuio/2Dcur
+		 * @param	command	the TUIO command, such as set
+		 */
+		void setAddress(const char *address, const char *command) {
+			int addressSize = roundUp4((int)strlen(address)+1);
+			int typeTagSize = roundUp4(INTS+FLOATS+3);
+			int commandSize = roundUp4((int)strlen(command)+1);
+			memset(header,0,TUIO_MAX_HEADER_SIZE);
+
+			char *p = header;
+			strcpy(p,address);
+			p += addressSize;
+
+			*p++ = ',';
+			*p++ = 's';
+			for (int i=0;i<INTS;i++) *p++ = 'i';
+			for (int i=0;i<FLOATS;i++) *p++ = 'f';
+			p = header + addressSize + typeTagSize;
+
+			strcpy(p,command);
+			headerSize = addressSize + typeTagSize + commandSize;
+		};
+
+		/**
+		 * Returns the total size of a message written by this TuioMessageTemplate in bytes.
+		 * @return	the total message size in bytes
+		 */
+		int getSize() const {
+			return headerSize + ARGUMENT_SIZE;
+		};
+
+		/**
+		 * Writes a complete message with the provided arguments to the provided destination,
+		 * which needs to hold at least getSize() bytes.
+		 *
+		 * @param	dst	the destination to write the message to
+		 * @param	ints	the INTS int32 arguments
+		 * @param	floats	the FLOATS float arguments
+		 */
+		void write(char *dst, const osc::int32 *ints, const float *floats) const {
+			memcpy(dst,header,headerSize);
+			char *p = dst + headerSize;
+			for (int i=0;i<INTS;i++,p+=4) putUInt32(p,(osc::uint32)ints[i]);
+			for (int i=0;i<FLOATS;i++,p+=4) {
+				osc::uint32 x;
+				memcpy(&x,&floats[i],4);
+				putUInt32(p,x);
+			}
+		};
+	};
+};
+#endif /* INCLUDED_TUIOMESSAGETEMPLATE_H */
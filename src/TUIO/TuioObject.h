@@ -29,6 +29,19 @@
 
 namespace TUIO {
 	
+	/**
+	 * The TuioObjectState structure is a plain copy of the TuioObject attributes, which are encoded
+	 * into a /tuio/2Dobj set message. It allows the TuioServer to serialize its objects
+	 * from a contiguous array without any virtual method calls.
+	 */
+	struct TuioObjectState {
+		long session_id;
+		int symbol_id;
+		float xpos, ypos, angle;
+		float x_speed, y_speed, rotation_speed;
+		float motion_accel, rotation_accel;
+	};
+	
 	/**
 	 * The TuioObject class encapsulates /tuio/2Dobj TUIO objects.
 	 *
@@ -116,6 +129,26 @@ namespace TUIO {
 			rotation_accel = 0.0f;
 		};
 		
+		/**
+		 * Reinitializes this TuioObject with the provided TuioTime, Session ID, Symbol ID, X and Y coordinate
+		 * and angle like the corresponding constructor, keeping the storage of its path. This allows the
+		 * TuioServer to reuse removed TuioObjects without any heap allocations.
+		 *
+		 * @param	ttime	the TuioTime to assign
+		 * @param	si	the Session ID  to assign
+		 * @param	sym	the Symbol ID  to assign
+		 * @param	xp	the X coordinate to assign
+		 * @param	yp	the Y coordinate to assign
+		 * @param	a	the angle to assign
+		 */
+		void reset (TuioTime ttime, long si, int sym, float xp, float yp, float a) {
+			TuioContainer::reset(ttime,si,xp,yp);
+			symbol_id = sym;
+			angle = a;
+			rotation_speed = 0.0f;
+			rotation_accel = 0.0f;
+		};
+		
 		/**
 		 * The destructor is doing nothing in particular. 
 		 */
@@ -191,11 +224,11 @@ namespace TUIO {
 		 * @param	a	the angle coordinate to assign
 		 */
 		void update (TuioTime ttime, float xp, float yp, float a) {
-			TuioPoint lastPoint = path.back();
+			TuioTime lastTime = currentTime;
 			TuioContainer::update(ttime,xp,yp);
 			
-			TuioTime diffTime = currentTime - lastPoint.getTuioTime();
-			float dt = diffTime.getTotalMilliseconds()/1000.0f;
+			TuioTime diffTime = currentTime - lastTime;
+			float dt = (float)diffTime.getTotalSeconds();
 			float last_angle = angle;
 			float last_rotation_speed = rotation_speed;
 			angle = a;
@@ -204,17 +237,19 @@ namespace TUIO {
 			if (da>M_PI*1.5) da-=(2*M_PI);
 			else if (da<M_PI*1.5) da+=(2*M_PI);
 			
-			rotation_speed = (float)da/dt;
-			rotation_accel =  (rotation_speed - last_rotation_speed)/dt;
+			if (dt>0) {
+				rotation_speed = (float)da/dt;
+				rotation_accel =  (rotation_speed - last_rotation_speed)/dt;
+			}
 			
 			if ((rotation_accel!=0) && (state==TUIO_STOPPED)) state = TUIO_ROTATING;
 		};
 		void update (TuioTime ttime, float xp, float yp, float zp, float a) {
-			TuioPoint lastPoint = path.back();
+			TuioTime lastTime = currentTime;
 			TuioContainer::update(ttime,xp,yp,zp);
 			
-			TuioTime diffTime = currentTime - lastPoint.getTuioTime();
-			float dt = diffTime.getTotalMilliseconds()/1000.0f;
+			TuioTime diffTime = currentTime - lastTime;
+			float dt = (float)diffTime.getTotalSeconds();
 			float last_angle = angle;
 			float last_rotation_speed = rotation_speed;
 			angle = a;
@@ -223,8 +258,10 @@ namespace TUIO {
 			if (da>M_PI*1.5) da-=(2*M_PI);
 			else if (da<M_PI*1.5) da+=(2*M_PI);
 			
-			rotation_speed = (float)da/dt;
-			rotation_accel =  (rotation_speed - last_rotation_speed)/dt;
+			if (dt>0) {
+				rotation_speed = (float)da/dt;
+				rotation_accel =  (rotation_speed - last_rotation_speed)/dt;
+			}
 			
 			if ((rotation_accel!=0) && (state==TUIO_STOPPED)) state = TUIO_ROTATING;
 		};
@@ -291,6 +328,25 @@ namespace TUIO {
 		float getRotationAccel() {
 			return rotation_accel;
 		};
+		
+		/**
+		 * Copies the current attributes of this TuioObject into the provided TuioObjectState.
+		 * This method is not virtual and can be inlined, overridden accessors are not taken into account.
+		 *
+		 * @param	tstate	the TuioObjectState to assign
+		 */
+		void getState(TuioObjectState &tstate) const {
+			tstate.session_id = session_id;
+			tstate.symbol_id = symbol_id;
+			tstate.xpos = xpos;
+			tstate.ypos = ypos;
+			tstate.angle = angle;
+			tstate.x_speed = x_speed;
+			tstate.y_speed = y_speed;
+			tstate.rotation_speed = rotation_speed;
+			tstate.motion_accel = motion_accel;
+			tstate.rotation_accel = rotation_accel;
+		};
 
 		/**
 		 * Returns true of this TuioObject is moving.
@@ -0,0 +1,143 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOPACKETBATCH_H
+#define INCLUDED_TUIOPACKETBATCH_H
+
+#include <vector>
+#include "osc/OscOutboundPacketStream.h"
+#include "TuioDestinationList.h"
+#include "TuioStreamServer.h"
+
+#define TUIO_MAX_BATCH 64
+
+namespace TUIO {
+
+	/**
+	 * The TuioPacketBatch class collects the OSC packets of a TUIO frame in separate buffers
+	 * and sends the same buffers to all destinations of a TuioDestinationList once the frame is complete,
+	 * as well as to all clients of an optional TuioStreamServer.
+	 * Packet buffers are allocated on demand and reused for all following frames.
+	 * If TUIO_MAX_BATCH packets are queued, the batch is sent before the next packet is started.
+	 *
+	 * @version 1.4
+	 */
+	class TuioPacketBatch {
+
+	private:
+		TuioDestinationList *destinations;
+		TuioStreamServer *stream;
+		int bufferSize;
+		int count;
+		bool fullFrame;
+
+		std::vector<char*> buffers;
+		std::vector<osc::OutboundPacketStream*> packets;
+		std::vector<const char*> data;
+		std::vector<int> sizes;
+
+		TuioPacketBatch(const TuioPacketBatch&);
+		TuioPacketBatch& operator=(const TuioPacketBatch&);
+
+	public:
+		/**
+		 * This constructor creates an empty TuioPacketBatch for the provided destinations and packet size.
+		 *
+		 * @param	list	the TuioDestinationList to send the packets to
+		 * @param	size	the maximum size of a single packet
+		 */
+		TuioPacketBatch(TuioDestinationList *list, int size):destinations(list),stream(NULL),bufferSize(size),count(0),fullFrame(false) {
+			data.reserve(TUIO_MAX_BATCH);
+			sizes.reserve(TUIO_MAX_BATCH);
+		};
+
+		/**
+		 * The destructor releases all packet buffers, queued packets are not sent.
+		 */
+		~TuioPacketBatch() {
+			for (unsigned int i=0;i<packets.size();i++) {
+				delete packets[i];
+				delete []buffers[i];
+			}
+		};
+
+		/**
+		 * Additionally sends all packets to the clients of the provided TuioStreamServer.
+		 *
+		 * @param	server	the TuioStreamServer or NULL
+		 */
+		void setStream(TuioStreamServer *server) {
+			stream = server;
+		};
+
+		/**
+		 * Marks the following packets as the start of a frame holding the complete state,
+		 * which lets stalled stream clients catch up again.
+		 */
+		void startFullFrame() {
+			fullFrame = true;
+		};
+
+		/**
+		 * Returns the cleared packet which is going to be queued next.
+		 * @return	the current packet
+		 */
+		osc::OutboundPacketStream* getPacket() {
+			if (count==(int)packets.size()) {
+				char *buffer = new char[bufferSize];
+				buffers.push_back(buffer);
+				packets.push_back(new osc::OutboundPacketStream(buffer,bufferSize));
+			}
+			osc::OutboundPacketStream *packet = packets[count];
+			packet->Clear();
+			return packet;
+		};
+
+		/**
+		 * Queues the current packet and returns the next cleared packet.
+		 * @return	the next packet
+		 */
+		osc::OutboundPacketStream* queue() {
+			data.push_back(packets[count]->Data());
+			sizes.push_back(packets[count]->Size());
+			count++;
+			if (count==TUIO_MAX_BATCH) return flush();
+			return getPacket();
+		};
+
+		/**
+		 * Sends all queued packets and returns the first cleared packet of the next batch.
+		 * @return	the next packet
+		 */
+		osc::OutboundPacketStream* flush() {
+			if (count>0) {
+				destinations->send(&data[0],&sizes[0],count);
+				if (stream!=NULL) stream->send(&data[0],&sizes[0],count,fullFrame);
+				fullFrame = false;
+			}
+			data.clear();
+			sizes.clear();
+			count = 0;
+			return getPacket();
+		};
+	};
+};
+#endif /* INCLUDED_TUIOPACKETBATCH_H */
@@ -0,0 +1,182 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOPATH_H
+#define INCLUDED_TUIOPATH_H
+
+#include <vector>
+#include <algorithm>
+#include "TuioPoint.h"
+
+#ifndef TUIO_DEFAULT_PATH_LENGTH
+#define TUIO_DEFAULT_PATH_LENGTH 128
+#endif
+
+namespace TUIO {
+
+	/**
+	 * The TuioPath class is a fixed capacity ring buffer holding the most recent positions of a {@link TuioContainer}.
+	 * Once the capacity is reached the oldest TuioPoint is overwritten, so the memory used by the path history
+	 * does not grow during the lifetime of a TUIO component. The storage grows with the path up to the capacity,
+	 * so short lived components only allocate a few TuioPoints. A capacity of zero disables the path history.
+	 *
+	 * @version 1.4
+	 */
+	class TuioPath {
+
+	private:
+		std::vector<TuioPoint> points;
+		int capacity;
+		int first;
+
+		static int& defaultLength() {
+			static int length = TUIO_DEFAULT_PATH_LENGTH;
+			return length;
+		}
+
+	public:
+		/**
+		 * The default constructor creates an empty TuioPath using the default path length.
+		 */
+		TuioPath() {
+			capacity = defaultLength();
+			first = 0;
+		};
+
+		/**
+		 * This constructor creates an empty TuioPath, which is able to hold the provided number of TuioPoints.
+		 *
+		 * @param	length	the maximum number of TuioPoints to keep
+		 */
+		TuioPath(int length) {
+			capacity = (length>0)?length:0;
+			first = 0;
+		};
+
+		/**
+		 * Sets the path length of all TuioPaths created afterwards, defaults to TUIO_DEFAULT_PATH_LENGTH.
+		 *
+		 * @param	length	the maximum number of TuioPoints to keep, zero disables the path history
+		 */
+		static void setDefaultLength(int length) {
+			defaultLength() = (length>0)?length:0;
+		};
+
+		/**
+		 * Returns the path length of newly created TuioPaths.
+		 * @return	the path length of newly created TuioPaths
+		 */
+		static int getDefaultLength() {
+			return defaultLength();
+		};
+
+		/**
+		 * Appends the provided TuioPoint, overwriting the oldest TuioPoint if the capacity has been reached.
+		 *
+		 * @param	tpoint	the TuioPoint to append
+		 */
+		void add(const TuioPoint &tpoint) {
+			if (capacity==0) return;
+			if ((int)points.size()<capacity) {
+				if (points.size()==points.capacity()) points.reserve(std::min(capacity,std::max(8,(int)points.size()*2)));
+				points.push_back(tpoint);
+			} else {
+				points[first] = tpoint;
+				first = (first+1)%capacity;
+			}
+		};
+
+		/**
+		 * Replaces the most recent TuioPoint with the provided TuioPoint.
+		 *
+		 * @param	tpoint	the TuioPoint to assign
+		 */
+		void replaceLast(const TuioPoint &tpoint) {
+			if (points.size()==0) add(tpoint);
+			else points[(first+points.size()-1)%capacity] = tpoint;
+		};
+
+		/**
+		 * Removes all TuioPoints from this TuioPath.
+		 */
+		void clear() {
+			points.clear();
+			first = 0;
+		};
+
+		/**
+		 * Removes all TuioPoints and restores the default path length, keeping the allocated storage.
+		 */
+		void reset() {
+			points.clear();
+			capacity = defaultLength();
+			first = 0;
+		};
+
+		/**
+		 * Changes the maximum number of TuioPoints of this TuioPath, keeping the most recent ones.
+		 *
+		 * @param	length	the maximum number of TuioPoints to keep
+		 */
+		void setCapacity(int length) {
+			if (length<0) length = 0;
+			if (length==capacity) return;
+
+			std::vector<TuioPoint> recent;
+			recent.reserve(std::min(length,size()));
+			int start = size()-length;
+			if (start<0) start = 0;
+			for (int i=start;i<size();i++) recent.push_back((*this)[i]);
+
+			points.swap(recent);
+			capacity = length;
+			first = 0;
+		};
+
+		/**
+		 * Returns the maximum number of TuioPoints of this TuioPath.
+		 * @return	the maximum number of TuioPoints of this TuioPath
+		 */
+		int getCapacity() const {
+			return capacity;
+		};
+
+		/**
+		 * Returns the number of TuioPoints currently stored in this TuioPath.
+		 * @return	the number of TuioPoints currently stored in this TuioPath
+		 */
+		int size() const {
+			return (int)points.size();
+		};
+
+		/**
+		 * Returns the TuioPoint at the provided position, where 0 refers to the oldest
+		 * and size()-1 refers to the most recent TuioPoint.
+		 *
+		 * @param	index	the position within 0..size()-1
+		 * @return	the TuioPoint at the provided position
+		 */
+		const TuioPoint& operator[](int index) const {
+			return points[(first+index)%capacity];
+		};
+	};
+};
+#endif /* INCLUDED_TUIOPATH_H */
@@ -154,7 +154,7 @@ namespace TUIO {
 		 * Returns the X coordinate of this TuioPoint. 
 		 * @return	the X coordinate of this TuioPoint
 		 */
-		float getX() { 
+		float getX() const {
 			return xpos;
 		};
 		
@@ -162,7 +162,7 @@ namespace TUIO {
 		 * Returns the Y coordinate of this TuioPoint. 
 		 * @return	the Y coordinate of this TuioPoint
 		 */
-		float getY() {
+		float getY() const {
 			return ypos;
 		};
 
@@ -170,7 +170,7 @@ namespace TUIO {
 		 * Returns the Z coordinate of this TuioPoint. 
 		 * @return	the Z coordinate of this TuioPoint
 		 */
-		float getZ() {
+		float getZ() const {
 			return zpos;
 		};
 		
@@ -273,7 +273,7 @@ namespace TUIO {
 		 *
 		 * @return	the  time stamp of this TuioPoint as TuioTime
 		 */
-		TuioTime getTuioTime() { 
+		TuioTime getTuioTime() const {
 			return currentTime;
 		};
 		
@@ -282,7 +282,7 @@ namespace TUIO {
 		 *
 		 * @return	the start time of this TuioPoint as TuioTime
 		 */
-		TuioTime getStartTime() {
+		TuioTime getStartTime() const {
 			return startTime;
 		};
 	};
@@ -0,0 +1,171 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOPOOL_H
+#define INCLUDED_TUIOPOOL_H
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+#define TUIO_POOL_CHUNK_SIZE 64
+
+namespace TUIO {
+
+	/**
+	 * The TuioPool class is a simple fixed size block allocator for TuioCursors and TuioObjects.
+	 * Memory is requested from the heap in chunks of TUIO_POOL_CHUNK_SIZE blocks, released blocks are
+	 * kept in an intrusive free list and handed out again, so that a session with a stable number of
+	 * components does not perform any heap allocations after warming up.
+	 * <p><code>
+	 * TuioCursor *tcur = new (pool.allocate()) TuioCursor(...);<br/>
+	 * ...<br/>
+	 * pool.release(tcur);<br/>
+	 * </code></p>
+	 * Components which own heap memory themselves, such as the path of a TuioCursor, can also be retired
+	 * without being destroyed, and are handed out again by reuse() for reinitialization in place.
+	 * <p><code>
+	 * TuioCursor *tcur = pool.reuse();<br/>
+	 * if (tcur!=NULL) tcur->reset(...);<br/>
+	 * else tcur = new (pool.allocate()) TuioCursor(...);<br/>
+	 * ...<br/>
+	 * pool.retire(tcur);<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	template<class T> class TuioPool {
+
+	private:
+		union Block {
+			Block *next;
+			char data[sizeof(T)];
+			double align_double;
+			long long align_long;
+			void *align_pointer;
+		};
+
+		std::vector<Block*> chunks;
+		std::vector<T*> retired;
+		Block *freeList;
+
+		void grow() {
+			Block *chunk = static_cast<Block*>(::operator new(sizeof(Block)*TUIO_POOL_CHUNK_SIZE));
+			chunks.push_back(chunk);
+			for (int i=TUIO_POOL_CHUNK_SIZE-1;i>=0;i--) {
+				chunk[i].next = freeList;
+				freeList = &chunk[i];
+			}
+		}
+
+		TuioPool(const TuioPool&);
+		TuioPool& operator=(const TuioPool&);
+
+	public:
+		/**
+		 * The default constructor creates an empty TuioPool, the first chunk is allocated on demand.
+		 */
+		TuioPool():freeList(NULL) {};
+
+		/**
+		 * The destructor destroys all retired T and returns all chunks to the heap.
+		 * Blocks which are still in use are not destroyed.
+		 */
+		~TuioPool() {
+			for (typename std::vector<T*>::iterator item=retired.begin(); item!=retired.end(); item++)
+				(*item)->~T();
+			for (typename std::vector<Block*>::iterator chunk=chunks.begin(); chunk!=chunks.end(); chunk++)
+				::operator delete(*chunk);
+		};
+
+		/**
+		 * Makes sure that at least the provided number of blocks can be handed out without further heap allocations.
+		 *
+		 * @param	count	the number of blocks to preallocate
+		 */
+		void reserve(int count) {
+			while ((int)(chunks.size()*TUIO_POOL_CHUNK_SIZE)<count) grow();
+			retired.reserve(count);
+		};
+
+		/**
+		 * Returns uninitialized storage for a single T, which is meant to be used with placement new.
+		 *
+		 * @return	uninitialized storage for a single T
+		 */
+		void* allocate() {
+			if (freeList==NULL) grow();
+			Block *block = freeList;
+			freeList = block->next;
+			return block;
+		};
+
+		/**
+		 * Destroys the provided T and returns its storage to the pool.
+		 *
+		 * @param	item	the pool allocated T to release
+		 */
+		void release(T *item) {
+			if (item==NULL) return;
+			item->~T();
+			Block *block = reinterpret_cast<Block*>(item);
+			block->next = freeList;
+			freeList = block;
+		};
+
+		/**
+		 * Keeps the provided T constructed for reuse() instead of destroying it.
+		 *
+		 * @param	item	the pool allocated T to retire
+		 */
+		void retire(T *item) {
+			if (item==NULL) return;
+			retired.push_back(item);
+		};
+
+		/**
+		 * Returns the most recently retired T, which is still constructed and needs to be reinitialized,
+		 * or NULL if there is no retired T.
+		 *
+		 * @return	a retired T or NULL
+		 */
+		T* reuse() {
+			if (retired.empty()) return NULL;
+			T *item = retired.back();
+			retired.pop_back();
+			return item;
+		};
+
+		/**
+		 * Returns true if the provided pointer refers to storage handed out by this TuioPool.
+		 *
+		 * @param	item	the pointer to test
+		 * @return	true if the provided pointer refers to storage of this TuioPool
+		 */
+		bool owns(const T *item) const {
+			const Block *block = reinterpret_cast<const Block*>(item);
+			for (typename std::vector<Block*>::const_iterator chunk=chunks.begin(); chunk!=chunks.end(); chunk++)
+				if ((block>=(*chunk)) && (block<(*chunk)+TUIO_POOL_CHUNK_SIZE)) return true;
+			return false;
+		};
+	};
+};
+#endif /* INCLUDED_TUIOPOOL_H */
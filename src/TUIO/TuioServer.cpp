@@ -20,146 +20,267 @@
 */
 
 #include "TuioServer.h"
+#include <unistd.h>
 
 using namespace TUIO;
 using namespace osc;
 
 #ifndef WIN32
-static void* ThreadFunc( void* obj )
+void* TuioServer::periodicThreadFunc( void* obj )
 #else
-static DWORD WINAPI ThreadFunc( LPVOID obj )
+DWORD WINAPI TuioServer::periodicThreadFunc( LPVOID obj )
 #endif
 {
-	TuioServer *tuioServer = static_cast<TuioServer*>(obj);
-	while ((tuioServer->isConnected()) && (tuioServer->periodicMessagesEnabled())) {
-		tuioServer->sendFullMessages();
+	static_cast<TuioServer*>(obj)->runPeriodicMessages();
+	return 0;
+};
+
+// the control mutex serializes enabling and disabling the periodic update thread
+void TuioServer::lockControl() {
 #ifndef WIN32
-		usleep(USEC_SECOND*tuioServer->getUpdateInterval());
+	pthread_mutex_lock(&controlMutex);
 #else
-		Sleep(MSEC_SECOND*tuioServer->getUpdateInterval());
+	WaitForSingleObject(controlMutex, INFINITE);
 #endif
-	}	
-	return 0;
-};
+}
 
-void TuioServer::enablePeriodicMessages(int interval) {
-	if (periodic_update) return;
+void TuioServer::unlockControl() {
+#ifndef WIN32
+	pthread_mutex_unlock(&controlMutex);
+#else
+	ReleaseMutex(controlMutex);
+#endif
+}
+
+void TuioServer::lockPeriodic() {
+#ifndef WIN32
+	pthread_mutex_lock(&periodicMutex);
+#else
+	WaitForSingleObject(periodicMutex, INFINITE);
+#endif
+}
+
+void TuioServer::unlockPeriodic() {
+#ifndef WIN32
+	pthread_mutex_unlock(&periodicMutex);
+#else
+	ReleaseMutex(periodicMutex);
+#endif
+}
+
+// waits until the deadline has passed or the periodic update has been reconfigured,
+// the periodic mutex needs to be locked and remains locked afterwards
+void TuioServer::waitPeriodic(long long deadline) {
+	long long now = TuioTime::getSystemTime().getTotalNanoseconds();
+	if (deadline<=now) return;
+#ifndef WIN32
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+	// the condition variable uses the same monotonic clock as TuioTime::getSystemTime()
+	long long absolute = deadline;
+#else
+	long long absolute = TuioTime::getWallTime().getTotalNanoseconds() + (deadline-now);
+#endif
+	struct timespec ts;
+	ts.tv_sec = (time_t)(absolute/NSEC_SECOND);
+	ts.tv_nsec = (long)(absolute%NSEC_SECOND);
+	pthread_cond_timedwait(&periodicCond, &periodicMutex, &ts);
+#else
+	unlockPeriodic();
+	WaitForSingleObject(periodicEvent, (DWORD)((deadline-now+NSEC_MILLISECOND-1)/NSEC_MILLISECOND));
+	lockPeriodic();
+#endif
+}
+
+void TuioServer::runPeriodicMessages() {
+	long long now = TuioTime::getSystemTime().getTotalNanoseconds();
+	long long deadline = now;
+	long long nextRegular = now;
+	long long adaptiveUntil = 0;
+	long lastAliveVersion = snapshots.getFront().aliveVersion;
+	int version = -1;
+
+	lockPeriodic();
+	while (periodic_update) {
+		// restart the schedule with an immediate full update if the intervals have been changed
+		if (version!=periodic_version) {
+			version = periodic_version;
+			deadline = nextRegular = now;
+		}
+		
+		long long interval = update_interval*NSEC_MILLISECOND;
+		long long adaptive = adaptive_interval*NSEC_MILLISECOND;
+		if ((adaptive<=0) || (adaptive>interval)) adaptive = 0;
+		
+		// stay in the adaptive mode for one regular interval after adding or removing
+		long aliveVersion = snapshots.getFront().aliveVersion;
+		if (aliveVersion!=lastAliveVersion) {
+			lastAliveVersion = aliveVersion;
+			adaptiveUntil = now + interval;
+		}
+		
+		if ((now>=nextRegular) || ((adaptive>0) && (now<adaptiveUntil))) {
+			unlockPeriodic();
+			sendFullMessages();
+			lockPeriodic();
+			nextRegular = deadline + interval;
+		}
+		
+		// advance the absolute deadline, skipping any deadlines which have been missed already
+		long long tick = (adaptive>0)?adaptive:interval;
+		deadline += tick;
+		now = TuioTime::getSystemTime().getTotalNanoseconds();
+		if (deadline<now) deadline = now + tick;
+		
+		while ((periodic_update) && (version==periodic_version) && (now<deadline)) {
+			waitPeriodic(deadline);
+			now = TuioTime::getSystemTime().getTotalNanoseconds();
+		}
+	}
+	unlockPeriodic();
+}
+
+void TuioServer::enablePeriodicMessagesMs(int interval, int adaptiveInterval) {
+	if (interval<1) interval = 1;
+	if (adaptiveInterval<0) adaptiveInterval = 0;
 	
+	lockControl();
+	lockPeriodic();
 	update_interval = interval;
+	adaptive_interval = adaptiveInterval;
+	bool running = periodic_update;
 	periodic_update = true;
+	periodic_version++;
+#ifndef WIN32
+	pthread_cond_signal(&periodicCond);
+#else
+	SetEvent(periodicEvent);
+#endif
+	unlockPeriodic();
 	
+	if (!running) {
 #ifndef WIN32
-	pthread_create(&thread , NULL, ThreadFunc, this);
+		pthread_create(&thread , NULL, periodicThreadFunc, this);
 #else
-	DWORD threadId;
-	thread = CreateThread( 0, 0, ThreadFunc, this, 0, &threadId );
+		DWORD threadId;
+		thread = CreateThread( 0, 0, periodicThreadFunc, this, 0, &threadId );
 #endif
+	}
+	unlockControl();
 }
 
 void TuioServer::disablePeriodicMessages() {
-	if (!periodic_update) return;
+	lockControl();
+	lockPeriodic();
+	if (!periodic_update) {
+		unlockPeriodic();
+		unlockControl();
+		return;
+	}
 	periodic_update = false;
+#ifndef WIN32
+	pthread_cond_signal(&periodicCond);
+#else
+	SetEvent(periodicEvent);
+#endif
+	unlockPeriodic();
 	
-#ifdef WIN32
-	if( thread ) CloseHandle( thread );
+#ifndef WIN32
+	pthread_join(thread, NULL);
+#else
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
 #endif
-	thread = NULL;	
+	thread = 0;
+	unlockControl();
 }
 
 void TuioServer::sendFullMessages() {
 	
+	// the snapshot of the last committed frame is never modified while it is in use here
+	const TuioFrameSnapshot &snapshot = snapshots.getFront();
+	int32 fseq[1] = { -1 };
+	int cursorSize = 4 + (mode3d?cursor3dSetMessage.getSize():cursorSetMessage.getSize());
+	int cursorFseqSize = 4 + cursorFseqMessage.getSize();
+	
 	// prepare the cursor packet
 	fullPacket->Clear();
 	(*fullPacket) << osc::BeginBundleImmediate;
 	
 	// add the cursor alive message
-	(*fullPacket) << osc::BeginMessage( cursorMessage) << "alive";
-	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++)
-		(*fullPacket) << (int32)((*tuioCursor)->getSessionID());	
-	(*fullPacket) << osc::EndMessage;	
+	fullAlive.clear();
+	for (unsigned int i=0;i<snapshot.cursors.size();i++)
+		fullAlive.push_back((int32)snapshot.cursors[i].session_id);
+	(*fullPacket) << osc::BeginMessage( cursorMessage) << "alive" << aliveArray(fullAlive) << osc::EndMessage;
 
 	// add all current cursor set messages
-	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
+	for (unsigned int c=0;c<snapshot.cursors.size();c++) {
 		
-		// start a new packet if we exceed the packet capacity
-		if ((fullPacket->Capacity()-fullPacket->Size())<CUR_MESSAGE_SIZE) {
+		// start a new packet if the set and fseq messages exceed the packet capacity
+		if ((int)fullPacket->Size()+cursorSize+cursorFseqSize>(int)fullPacket->Capacity()) {
 			
 			// add the immediate fseq message and send the cursor packet
-			(*fullPacket) << osc::BeginMessage( cursorMessage) << "fseq" << -1 << osc::EndMessage;
+			cursorFseqMessage.write(fullPacket->ReserveMessage(cursorFseqMessage.getSize()),fseq,NULL);
 			(*fullPacket) << osc::EndBundle;
-			socket->Send( fullPacket->Data(), fullPacket->Size() );
+			fullPacket = fullBatch->queue();
 
 			// prepare the new cursor packet
 			fullPacket->Clear();	
 			(*fullPacket) << osc::BeginBundleImmediate;
 			
-			// add the cursor alive message
-			(*fullPacket) << osc::BeginMessage( cursorMessage) << "alive";
-			for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++)
-				(*fullPacket) << (int32)((*tuioCursor)->getSessionID());	
-			(*fullPacket) << osc::EndMessage;				
+			// add the cursor alive message unless compact frames are enabled
+			if (!compact_frames) (*fullPacket) << osc::BeginMessage( cursorMessage) << "alive" << aliveArray(fullAlive) << osc::EndMessage;
 		}
 
 		// add the actual cursor set message
-		if (mode3d) {
-			(*fullPacket) << osc::BeginMessage( "/tuio/3Dcur") << "set";
-			(*fullPacket) << (int32)((*tuioCursor)->getSessionID()) << (*tuioCursor)->getX() << (*tuioCursor)->getY() << (*tuioCursor)->getZ();
-			(*fullPacket) << (*tuioCursor)->getXSpeed() << (*tuioCursor)->getYSpeed() << (*tuioCursor)->getZSpeed() <<(*tuioCursor)->getMotionAccel();	
-			(*fullPacket) << osc::EndMessage;
-		} else {
-			(*fullPacket) << osc::BeginMessage( "/tuio/2Dcur") << "set";
-			(*fullPacket) << (int32)((*tuioCursor)->getSessionID()) << (*tuioCursor)->getX() << (*tuioCursor)->getY();
-			(*fullPacket) << (*tuioCursor)->getXSpeed() << (*tuioCursor)->getYSpeed() <<(*tuioCursor)->getMotionAccel();	
-			(*fullPacket) << osc::EndMessage;	
-		}
+		addCursorMessage(fullPacket,snapshot.cursors[c]);
 	}
 	
 	// add the immediate fseq message and send the cursor packet
-	(*fullPacket) << osc::BeginMessage( cursorMessage) << "fseq" << -1 << osc::EndMessage;
+	cursorFseqMessage.write(fullPacket->ReserveMessage(cursorFseqMessage.getSize()),fseq,NULL);
 	(*fullPacket) << osc::EndBundle;
-	socket->Send( fullPacket->Data(), fullPacket->Size() );
+	fullPacket = fullBatch->queue();
+	
+	int objectSize = 4 + objectSetMessage.getSize();
+	int objectFseqSize = 4 + objectFseqMessage.getSize();
 	
 	// prepare the object packet
 	fullPacket->Clear();
 	(*fullPacket) << osc::BeginBundleImmediate;
 	
 	// add the object alive message
-	(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive";
-	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++)
-		(*fullPacket) << (int32)((*tuioObject)->getSessionID());	
-	(*fullPacket) << osc::EndMessage;	
+	fullAlive.clear();
+	for (unsigned int i=0;i<snapshot.objects.size();i++)
+		fullAlive.push_back((int32)snapshot.objects[i].session_id);
+	(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive" << aliveArray(fullAlive) << osc::EndMessage;
 
-	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
+	for (unsigned int o=0;o<snapshot.objects.size();o++) {
 		
-		// start a new packet if we exceed the packet capacity
-		if ((fullPacket->Capacity()-fullPacket->Size())<OBJ_MESSAGE_SIZE) {
+		// start a new packet if the set and fseq messages exceed the packet capacity
+		if ((int)fullPacket->Size()+objectSize+objectFseqSize>(int)fullPacket->Capacity()) {
 			// add the immediate fseq message and send the object packet
-			(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "fseq" << -1 << osc::EndMessage;
+			objectFseqMessage.write(fullPacket->ReserveMessage(objectFseqMessage.getSize()),fseq,NULL);
 			(*fullPacket) << osc::EndBundle;
-			socket->Send( fullPacket->Data(), fullPacket->Size() );
+			fullPacket = fullBatch->queue();
 			
 			// prepare the new object packet
 			fullPacket->Clear();	
 			(*fullPacket) << osc::BeginBundleImmediate;
 			
-			// add the object alive message
-			(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive";
-			for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++)
-				(*fullPacket) << (int32)((*tuioObject)->getSessionID());	
-			(*fullPacket) << osc::EndMessage;	
+			// add the object alive message unless compact frames are enabled
+			if (!compact_frames) (*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive" << aliveArray(fullAlive) << osc::EndMessage;
 		}
 
 		// add the actual object set message
-		(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "set";
-		(*fullPacket) << (int32)((*tuioObject)->getSessionID()) << (*tuioObject)->getSymbolID() << (*tuioObject)->getX() << (*tuioObject)->getY() << (*tuioObject)->getAngle();
-		(*fullPacket) << (*tuioObject)->getXSpeed() << (*tuioObject)->getYSpeed() << (*tuioObject)->getRotationSpeed() << (*tuioObject)->getMotionAccel() << (*tuioObject)->getRotationAccel();	
-		(*fullPacket) << osc::EndMessage;
-		
+		addObjectMessage(fullPacket,snapshot.objects[o]);
+
 	}
 	// add the immediate fseq message and send the object packet
-	(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "fseq" << -1 << osc::EndMessage;
+	objectFseqMessage.write(fullPacket->ReserveMessage(objectFseqMessage.getSize()),fseq,NULL);
 	(*fullPacket) << osc::EndBundle;
-	socket->Send( fullPacket->Data(), fullPacket->Size() );
+	fullPacket = fullBatch->queue();
+	
+	// send all cursor and object packets at once
+	fullPacket = fullBatch->flush();
 }
 
 TuioServer::TuioServer(bool mode3d) {
@@ -184,66 +305,171 @@ void TuioServer::initialize(const char *host, int port, int size, bool mode3d) {
 	} else {
 		cursorMessage = "/tuio/2Dcur";
 	}
+	
+	cursorSetMessage.setAddress("/tuio/2Dcur","set");
+	cursor3dSetMessage.setAddress("/tuio/3Dcur","set");
+	objectSetMessage.setAddress("/tuio/2Dobj","set");
+	cursorFseqMessage.setAddress(cursorMessage,"fseq");
+	objectFseqMessage.setAddress("/tuio/2Dobj","fseq");
 
 	try {
-		long unsigned int ip = GetHostByName(host);
-		socket = new UdpTransmitSocket(IpEndpointName(ip, port));
-
-		oscBuffer = new char[size];
-		oscPacket = new osc::OutboundPacketStream(oscBuffer,size);
-		fullBuffer = new char[size];
-		fullPacket = new osc::OutboundPacketStream(fullBuffer,size);
+		socket = new UdpSocket();
 	} catch (std::exception &e) { 
 		std::cout << "could not create socket" << std::endl;
 		socket = NULL;
 	}
 	
+	destinations = new TuioDestinationList(socket);
+	destinations->add(host,port);
+	frameBatch = new TuioPacketBatch(destinations,size);
+	oscPacket = frameBatch->getPacket();
+	fullBatch = new TuioPacketBatch(destinations,size);
+	fullPacket = fullBatch->getPacket();
+	
+	cursorList.reserve(INITIAL_CAPACITY);
+	objectList.reserve(INITIAL_CAPACITY);
+	cursorPool.reserve(INITIAL_CAPACITY);
+	objectPool.reserve(INITIAL_CAPACITY);
+	cursorIdAllocator.reserve(INITIAL_CAPACITY);
+	cursorAlive.reserve(INITIAL_CAPACITY);
+	cursorStates.reserve(INITIAL_CAPACITY);
+	objectAlive.reserve(INITIAL_CAPACITY);
+	objectStates.reserve(INITIAL_CAPACITY);
+	fullAlive.reserve(INITIAL_CAPACITY);
+
+#ifndef WIN32
+	pthread_mutex_init(&controlMutex,NULL);
+	pthread_mutex_init(&periodicMutex,NULL);
+	pthread_condattr_t condAttr;
+	pthread_condattr_init(&condAttr);
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+	pthread_condattr_setclock(&condAttr,CLOCK_MONOTONIC);
+#endif
+	pthread_cond_init(&periodicCond,&condAttr);
+	pthread_condattr_destroy(&condAttr);
+#else
+	controlMutex = CreateMutex(NULL,FALSE,NULL);
+	periodicMutex = CreateMutex(NULL,FALSE,NULL);
+	periodicEvent = CreateEvent(NULL,FALSE,FALSE,NULL);
+#endif
+	thread = 0;
+	sharedMemory = NULL;
+	stream = NULL;
+	fullFrame = false;
+	update_interval = MSEC_SECOND;
+	adaptive_interval = 0;
+	periodic_version = 0;
+	updateAlive = false;
+	aliveVersion = 0;
+
 	currentFrameTime = TuioTime::getSessionTime().getSeconds();
-	currentFrame = sessionID = maxCursorID = -1;
+	currentFrame = sessionID = -1;
+	frameBytes = frameDatagrams = 0;
 	verbose = updateObject = updateCursor = false;
 	lastObjectUpdate = lastCursorUpdate = currentFrameTime.getSeconds();
 	
 	sendEmptyCursorBundle();
 	sendEmptyObjectBundle();
+	oscPacket = frameBatch->flush();
 
 	periodic_update = false;
 	full_update = false;
+	delta_update = false;
+	delta_epsilon = 0.0f;
+	compact_frames = false;
 	connected = true;
 }
 
 TuioServer::~TuioServer() {
+	disablePeriodicMessages();
+	disableSharedMemory();
 	connected = false;
 
 	sendEmptyCursorBundle();
 	sendEmptyObjectBundle();
+	oscPacket = frameBatch->flush();
+
+	for (int i=0;i<cursorList.size();i++)
+		if (cursorPool.owns(cursorList[i])) cursorPool.release(cursorList[i]);
+	for (int i=0;i<objectList.size();i++)
+		if (objectPool.owns(objectList[i])) objectPool.release(objectList[i]);
 
-	delete oscPacket;
-	delete []oscBuffer;
-	delete fullPacket;
-	delete []fullBuffer;
+	delete frameBatch;
+	delete fullBatch;
+	delete stream;
+	delete destinations;
 	delete socket;
+
+#ifndef WIN32
+	pthread_cond_destroy(&periodicCond);
+	pthread_mutex_destroy(&periodicMutex);
+	pthread_mutex_destroy(&controlMutex);
+#else
+	CloseHandle(periodicEvent);
+	CloseHandle(periodicMutex);
+	CloseHandle(controlMutex);
+#endif
+}
+
+
+void TuioServer::logObject(const char *label, TuioObject *tobj, bool position, bool motion) {
+	if (!TuioLog::isEnabled(TUIO_LOG_INFO)) return;
+
+	float values[8];
+	int count = 0;
+	if (position) {
+		values[count++] = tobj->getX();
+		values[count++] = tobj->getY();
+		values[count++] = tobj->getAngle();
+	}
+	if (motion) {
+		values[count++] = tobj->getXSpeed();
+		values[count++] = tobj->getYSpeed();
+		values[count++] = tobj->getRotationSpeed();
+		values[count++] = tobj->getMotionAccel();
+		values[count++] = tobj->getRotationAccel();
+	}
+	TuioLog::values(TUIO_LOG_INFO, label, tobj->getSymbolID(), tobj->getSessionID(), values, count);
 }
 
+void TuioServer::logCursor(const char *label, TuioCursor *tcur, bool position, bool motion) {
+	if (!TuioLog::isEnabled(TUIO_LOG_INFO)) return;
+
+	float values[7];
+	int count = 0;
+	if (position) {
+		values[count++] = tcur->getX();
+		values[count++] = tcur->getY();
+		if (mode3d) values[count++] = tcur->getZ();
+	}
+	if (motion) {
+		values[count++] = tcur->getXSpeed();
+		values[count++] = tcur->getYSpeed();
+		if (mode3d) values[count++] = tcur->getZSpeed();
+		values[count++] = tcur->getMotionAccel();
+	}
+	TuioLog::values(TUIO_LOG_INFO, label, tcur->getCursorID(), tcur->getSessionID(), values, count);
+}
 
 TuioObject* TuioServer::addTuioObject(int f_id, float x, float y, float a) {
 	sessionID++;
-	TuioObject *tobj = new TuioObject(currentFrameTime, sessionID, f_id, x, y, a);
-	objectList.push_back(tobj);
-	updateObject = true;
+	TuioObject *tobj = objectPool.reuse();
+	if (tobj!=NULL) tobj->reset(currentFrameTime, sessionID, f_id, x, y, a);
+	else tobj = new (objectPool.allocate()) TuioObject(currentFrameTime, sessionID, f_id, x, y, a);
+	tobj->setSlotHandle(objectList.insert(tobj));
+	updateObject = updateAlive = true;
 
-	if (verbose)
-		std::cout << "add obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ") "<< tobj->getX() << " " << tobj->getY() << " " << tobj->getAngle() << std::endl;
+	if (verbose) logObject("add obj",tobj,true,false);
 
 	return tobj;
 }
 
 void TuioServer::addExternalTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
-	objectList.push_back(tobj);
-	updateObject = true;
+	tobj->setSlotHandle(objectList.insert(tobj));
+	updateObject = updateAlive = true;
 	
-	if (verbose)
-		std::cout << "add obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ") "<< tobj->getX() << " " << tobj->getY() << " " << tobj->getAngle() << std::endl;
+	if (verbose) logObject("add obj",tobj,true,false);
 }
 
 void TuioServer::updateTuioObject(TuioObject *tobj, float x, float y, float a) {
@@ -252,82 +478,57 @@ void TuioServer::updateTuioObject(TuioObject *tobj, float x, float y, float a) {
 	tobj->update(currentFrameTime,x,y,a);
 	updateObject = true;
 
-	if (verbose && tobj->isMoving())		
-		std::cout << "set obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ") "<< tobj->getX() << " " << tobj->getY() << " " << tobj->getAngle() 
-		<< " " << tobj->getXSpeed() << " " << tobj->getYSpeed() << " " << tobj->getRotationSpeed() << " " << tobj->getMotionAccel() << " " << tobj->getRotationAccel() << std::endl;	
+	if (verbose && tobj->isMoving()) logObject("set obj",tobj,true,true);
 }
 
 void TuioServer::updateExternalTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
 	updateObject = true;
-	if (verbose && tobj->isMoving())	
-		std::cout << "set obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ") "<< tobj->getX() << " " << tobj->getY() << " " << tobj->getAngle() 
-		<< " " << tobj->getXSpeed() << " " << tobj->getYSpeed() << " " << tobj->getRotationSpeed() << " " << tobj->getMotionAccel() << " " << tobj->getRotationAccel() << std::endl;	
+	if (verbose && tobj->isMoving()) logObject("set obj",tobj,true,true);
 }
 
 void TuioServer::removeTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
-	objectList.remove(tobj);
-	delete tobj;
-	updateObject = true;
+	objectList.remove(tobj->getSlotHandle());
+	updateObject = updateAlive = true;
 	
-	if (verbose)
-		std::cout << "del obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ")" << std::endl;
+	if (verbose) logObject("del obj",tobj,false,false);
+
+	// TuioObjects added with addExternalTuioObject() have not been allocated from the pool
+	if (objectPool.owns(tobj)) objectPool.retire(tobj);
+	else delete tobj;
 }
 
 void TuioServer::removeExternalTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
-	objectList.remove(tobj);
-	updateObject = true;
+	objectList.remove(tobj->getSlotHandle());
+	updateObject = updateAlive = true;
 	
-	if (verbose)
-		std::cout << "del obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ")" << std::endl;
+	if (verbose) logObject("del obj",tobj,false,false);
 }
 
 TuioCursor* TuioServer::addTuioCursor(float x, float y, float z) {
 	sessionID++;
 	
-	int cursorID = (int)cursorList.size();
-	if (((int)(cursorList.size())<=maxCursorID) && ((int)(freeCursorList.size())>0)) {
-		std::list<TuioCursor*>::iterator closestCursor = freeCursorList.begin();
-		
-		for(std::list<TuioCursor*>::iterator iter = freeCursorList.begin();iter!= freeCursorList.end(); iter++) {
-			if((*iter)->getDistance(x,y,z)<(*closestCursor)->getDistance(x,y,z)) closestCursor = iter;
-		}
-		
-		TuioCursor *freeCursor = (*closestCursor);
-		cursorID = (*closestCursor)->getCursorID();
-		freeCursorList.erase(closestCursor);
-		delete freeCursor;
-	} else maxCursorID = cursorID;	
-	
-	TuioCursor *tcur = new TuioCursor(currentFrameTime, sessionID, cursorID, x, y, z);
-	cursorList.push_back(tcur);
-	updateCursor = true;
+	int cursorID = cursorIdAllocator.allocate(x,y,z);
+	
+	TuioCursor *tcur = cursorPool.reuse();
+	if (tcur!=NULL) tcur->reset(currentFrameTime, sessionID, cursorID, x, y, z);
+	else tcur = new (cursorPool.allocate()) TuioCursor(currentFrameTime, sessionID, cursorID, x, y, z);
+	tcur->setSlotHandle(cursorList.insert(tcur));
+	updateCursor = updateAlive = true;
 
-	if (verbose) {
-		if (mode3d) {
-			std::cout << "add cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << " " << tcur->getZ() << std::endl;
-		} else {
-			std::cout << "add cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << std::endl;
-		}
-	}
+	if (verbose) logCursor("add cur",tcur,true,false);
 
 	return tcur;
 }
 
 void TuioServer::addExternalTuioCursor(TuioCursor *tcur) {
 	if (tcur==NULL) return;
-	cursorList.push_back(tcur);
-	updateCursor = true;
+	tcur->setSlotHandle(cursorList.insert(tcur));
+	updateCursor = updateAlive = true;
 	
-	if (verbose) {
-		if (mode3d) {
-			std::cout << "add cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << " " << tcur->getZ() << std::endl;
-		} else {
-			std::cout << "add cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << std::endl;
-		}
-	}
+	if (verbose) logCursor("add cur",tcur,true,false);
 }
 
 void TuioServer::updateTuioCursor(TuioCursor *tcur,float x, float y, float z) {
@@ -336,78 +537,35 @@ void TuioServer::updateTuioCursor(TuioCursor *tcur,float x, float y, float z) {
 	tcur->update(currentFrameTime,x,y,z);
 	updateCursor = true;
 
-	if (verbose && tcur->isMoving()) {	 	
-		if (mode3d) {
-			std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << " " << tcur->getZ() 
-			<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed() << " " << tcur->getZSpeed() << " " << tcur->getMotionAccel() << " " << std::endl;
-		} else {
-			std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() 
-			<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed() << " " << tcur->getMotionAccel() << " " << std::endl;
-		}
-	}
+	if (verbose && tcur->isMoving()) logCursor("set cur",tcur,true,true);
 }
 
 void TuioServer::updateExternalTuioCursor(TuioCursor *tcur) {
 	if (tcur==NULL) return;
 	updateCursor = true;
-	if (verbose && tcur->isMoving()) {
-		if (mode3d) {
-			std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << " " << tcur->getZ() 
-			<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed() << " " << tcur->getZSpeed() << " " << tcur->getMotionAccel() << " " << std::endl;
-		} else {
-			std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() 
-			<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed() << " " << tcur->getMotionAccel() << " " << std::endl;
-		}
-	}
+	if (verbose && tcur->isMoving()) logCursor("set cur",tcur,true,true);
 }
 
 void TuioServer::removeTuioCursor(TuioCursor *tcur) {
 	if (tcur==NULL) return;
-	cursorList.remove(tcur);
+	cursorList.remove(tcur->getSlotHandle());
 	tcur->remove(currentFrameTime);
-	updateCursor = true;
+	updateCursor = updateAlive = true;
 
-	if (verbose)
-		std::cout << "del cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ")" << std::endl;
+	if (verbose) logCursor("del cur",tcur,false,false);
 
-	if (tcur->getCursorID()==maxCursorID) {
-		maxCursorID = -1;
-		delete tcur;
-		
-		if (cursorList.size()>0) {
-			std::list<TuioCursor*>::iterator clist;
-			for (clist=cursorList.begin(); clist != cursorList.end(); clist++) {
-				int cursorID = (*clist)->getCursorID();
-				if (cursorID>maxCursorID) maxCursorID=cursorID;
-			}
-			
-			freeCursorBuffer.clear();
-			for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-				TuioCursor *freeCursor = (*flist);
-				if (freeCursor->getCursorID()>maxCursorID) delete freeCursor;
-				else freeCursorBuffer.push_back(freeCursor);
-			}
-			freeCursorList = freeCursorBuffer;
-			
-		} else {
-			for (std::list<TuioCursor*>::iterator flist=freeCursorList.begin(); flist != freeCursorList.end(); flist++) {
-				TuioCursor *freeCursor = (*flist);
-				delete freeCursor;
-			}
-			freeCursorList.clear();
-		} 
-	} else if (tcur->getCursorID()<maxCursorID) {
-		freeCursorList.push_back(tcur);
-	}
+	cursorIdAllocator.release(tcur->getCursorID(),tcur->getX(),tcur->getY(),tcur->getZ());
+	// TuioCursors added with addExternalTuioCursor() have not been allocated from the pool
+	if (cursorPool.owns(tcur)) cursorPool.retire(tcur);
+	else delete tcur;
 }
 
 void TuioServer::removeExternalTuioCursor(TuioCursor *tcur) {
 	if (tcur==NULL) return;
-	cursorList.remove(tcur);
-	updateCursor = true;
+	cursorList.remove(tcur->getSlotHandle());
+	updateCursor = updateAlive = true;
 	
-	if (verbose)
-		std::cout << "del cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ")" << std::endl;
+	if (verbose) logCursor("del cur",tcur,false,false);
 }
 
 long TuioServer::getSessionID() {
@@ -430,47 +588,147 @@ void TuioServer::initFrame(TuioTime ttime) {
 
 void TuioServer::commitFrame() {
 	
+	frameBytes = frameDatagrams = 0;
+	
+	// send the complete state to stream clients which have just connected or stalled
+	fullFrame = (stream!=NULL) && (stream->wantsFullFrame());
+	if (fullFrame) {
+		updateCursor = updateObject = true;
+		frameBatch->startFullFrame();
+	}
+	bool changed = updateCursor || updateObject;
+	
 	if(updateCursor) {
-		startCursorBundle();
-		for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
+		int messageSize = 4 + (mode3d?cursor3dSetMessage.getSize():cursorSetMessage.getSize());
+		int fseqSize = 4 + cursorFseqMessage.getSize();
+		
+		updateCursorStates();
+		startCursorBundle(true);
+		for (unsigned int i=0;i<cursorStates.size();i++) {
 			
-			// start a new packet if we exceed the packet capacity
-			if ((oscPacket->Capacity()-oscPacket->Size())<CUR_MESSAGE_SIZE) {
+			// start a new packet if the set and fseq messages exceed the packet capacity
+			if ((int)oscPacket->Size()+messageSize+fseqSize>(int)oscPacket->Capacity()) {
 				sendCursorBundle(currentFrame);
-				startCursorBundle();
+				startCursorBundle(!compact_frames);
 			}
 
-			TuioCursor *tcur = (*tuioCursor);
-			if ((full_update) || (tcur->getTuioTime()==currentFrameTime)) addCursorMessage(tcur);				
+			addCursorMessage(oscPacket,cursorStates[i]);
 		}
 		sendCursorBundle(currentFrame);
 	} else if ((!periodic_update) && (lastCursorUpdate<currentFrameTime.getSeconds())) {
 		lastCursorUpdate = currentFrameTime.getSeconds();
-		startCursorBundle();
+		updateCursorStates();
+		startCursorBundle(true);
 		sendCursorBundle(currentFrame);
 	}
 	updateCursor = false;
 	
 	if(updateObject) {
-		startObjectBundle();
-		for (std::list<TuioObject*>::iterator  tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
+		int messageSize = 4 + objectSetMessage.getSize();
+		int fseqSize = 4 + objectFseqMessage.getSize();
+		
+		updateObjectStates();
+		startObjectBundle(true);
+		for (unsigned int i=0;i<objectStates.size();i++) {
 			
-			// start a new packet if we exceed the packet capacity
-			if ((oscPacket->Capacity()-oscPacket->Size())<OBJ_MESSAGE_SIZE) {
+			// start a new packet if the set and fseq messages exceed the packet capacity
+			if ((int)oscPacket->Size()+messageSize+fseqSize>(int)oscPacket->Capacity()) {
 				sendObjectBundle(currentFrame);
-				startObjectBundle();
+				startObjectBundle(!compact_frames);
 			}
 			
-			TuioObject *tobj = (*tuioObject);
-			if  ((full_update) || (tobj->getTuioTime()==currentFrameTime)) addObjectMessage(tobj);
+			addObjectMessage(oscPacket,objectStates[i]);
 		} 
 		sendObjectBundle(currentFrame);
 	} else if ((!periodic_update) && (lastObjectUpdate<currentFrameTime.getSeconds())) {
 		lastObjectUpdate = currentFrameTime.getSeconds();
-		startObjectBundle();
+		updateObjectStates();
+		startObjectBundle(true);
 		sendObjectBundle(currentFrame);
 	}
 	updateObject = false;
+	
+	// send all cursor and object packets of this frame at once
+	oscPacket = frameBatch->flush();
+	fullFrame = false;
+	
+	// the previously published snapshot remains valid if nothing has changed
+	if (updateAlive) aliveVersion++;
+	updateAlive = false;
+	if (changed) publishSnapshot();
+}
+
+void TuioServer::publishSnapshot() {
+	TuioFrameSnapshot &snapshot = snapshots.getBack();
+	snapshot.cursors.resize(cursorList.size());
+	for (int i=0;i<cursorList.size();i++)
+		cursorList[i]->getState(snapshot.cursors[i]);
+	snapshot.objects.resize(objectList.size());
+	for (int i=0;i<objectList.size();i++)
+		objectList[i]->getState(snapshot.objects[i]);
+	snapshot.aliveVersion = aliveVersion;
+	
+	if (sharedMemory!=NULL)
+		sharedMemory->write(currentFrame, snapshot.cursors.empty()?NULL:&snapshot.cursors[0], (int)snapshot.cursors.size(),
+			snapshot.objects.empty()?NULL:&snapshot.objects[0], (int)snapshot.objects.size());
+	
+	snapshots.publish();
+}
+
+bool TuioServer::listenTcp(int port) {
+	if (stream==NULL) {
+		stream = new TuioStreamServer();
+		frameBatch->setStream(stream);
+	}
+	return stream->listenTcp(port);
+}
+
+bool TuioServer::listenUnix(const char *path) {
+	if (stream==NULL) {
+		stream = new TuioStreamServer();
+		frameBatch->setStream(stream);
+	}
+	return stream->listenUnix(path);
+}
+
+bool TuioServer::enableSharedMemory(const char *name, int mode) {
+	disableSharedMemory();
+	sharedMemory = TuioSharedMemory::createWriter(name,mode);
+	if (sharedMemory==NULL) return false;
+	
+	// start with the current state
+	publishSnapshot();
+	return true;
+}
+
+void TuioServer::disableSharedMemory() {
+	if (sharedMemory==NULL) return;
+	
+	// clients remove all TuioCursors and TuioObjects with an empty frame
+	sharedMemory->write(currentFrame, NULL, 0, NULL, 0);
+	delete sharedMemory;
+	sharedMemory = NULL;
+}
+
+void TuioServer::updateCursorStates() {
+	cursorAlive.clear();
+	cursorStates.clear();
+	
+	TuioCursorState tstate;
+	for (int i=0;i<cursorList.size();i++) {
+		TuioCursor *tcur = cursorList[i];
+		tcur->getState(tstate);
+		cursorAlive.push_back((int32)tstate.session_id);
+		if ((full_update) || (fullFrame)) {
+			tcur->setSentState(tstate);
+			cursorStates.push_back(tstate);
+		} else if (tcur->getTuioTime()==currentFrameTime) {
+			// skip cursors which have not changed noticeably since they have been sent
+			if ((delta_update) && (!tcur->differsFromSentState(tstate,delta_epsilon))) continue;
+			tcur->setSentState(tstate);
+			cursorStates.push_back(tstate);
+		}
+	}
 }
 
 void TuioServer::sendEmptyCursorBundle() {
@@ -479,38 +737,49 @@ void TuioServer::sendEmptyCursorBundle() {
 	(*oscPacket) << osc::BeginMessage( cursorMessage) << "alive" << osc::EndMessage;	
 	(*oscPacket) << osc::BeginMessage( cursorMessage) << "fseq" << -1 << osc::EndMessage;
 	(*oscPacket) << osc::EndBundle;
-	socket->Send( oscPacket->Data(), oscPacket->Size() );
+	oscPacket = frameBatch->queue();
 }
 
-void TuioServer::startCursorBundle() {	
+void TuioServer::startCursorBundle(bool alive) {	
 	oscPacket->Clear();	
 	(*oscPacket) << osc::BeginBundleImmediate;
 	
-	(*oscPacket) << osc::BeginMessage( cursorMessage) << "alive";
-	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
-		(*oscPacket) << (int32)((*tuioCursor)->getSessionID());	
-	}
-	(*oscPacket) << osc::EndMessage;	
+	// compact frames only send the alive message with the first packet of a frame
+	if (!alive) return;
+	(*oscPacket) << osc::BeginMessage( cursorMessage) << "alive" << aliveArray(cursorAlive) << osc::EndMessage;
 }
 
-void TuioServer::addCursorMessage(TuioCursor *tcur) {
+void TuioServer::addCursorMessage(osc::OutboundPacketStream *packet, const TuioCursorState &tstate) {
+	int32 ints[1] = { (int32)tstate.session_id };
 	if (mode3d) {
-		(*oscPacket) << osc::BeginMessage( "/tuio/3Dcur") << "set";
-		(*oscPacket) << (int32)(tcur->getSessionID()) << tcur->getX() << tcur->getY() << tcur->getZ();
-		(*oscPacket) << tcur->getXSpeed() << tcur->getYSpeed() << tcur->getZSpeed() << tcur->getMotionAccel();	
-		(*oscPacket) << osc::EndMessage;
+		float floats[7] = { tstate.xpos, tstate.ypos, tstate.zpos, tstate.x_speed, tstate.y_speed, tstate.z_speed, tstate.motion_accel };
+		cursor3dSetMessage.write(packet->ReserveMessage(cursor3dSetMessage.getSize()),ints,floats);
 	} else {
-		(*oscPacket) << osc::BeginMessage( "/tuio/2Dcur") << "set";
-		(*oscPacket) << (int32)(tcur->getSessionID()) << tcur->getX() << tcur->getY();
-		(*oscPacket) << tcur->getXSpeed() << tcur->getYSpeed() << tcur->getMotionAccel();	
-		(*oscPacket) << osc::EndMessage;
+		float floats[5] = { tstate.xpos, tstate.ypos, tstate.x_speed, tstate.y_speed, tstate.motion_accel };
+		cursorSetMessage.write(packet->ReserveMessage(cursorSetMessage.getSize()),ints,floats);
 	}
 }
 
 void TuioServer::sendCursorBundle(long fseq) {
-	(*oscPacket) << osc::BeginMessage( cursorMessage) << "fseq" << (int32)fseq << osc::EndMessage;
+	int32 ints[1] = { (int32)fseq };
+	cursorFseqMessage.write(oscPacket->ReserveMessage(cursorFseqMessage.getSize()),ints,NULL);
 	(*oscPacket) << osc::EndBundle;
-	socket->Send( oscPacket->Data(), oscPacket->Size() );
+	frameBytes += oscPacket->Size();
+	frameDatagrams++;
+	oscPacket = frameBatch->queue();
+}
+
+void TuioServer::updateObjectStates() {
+	objectAlive.clear();
+	objectStates.clear();
+	
+	TuioObjectState tstate;
+	for (int i=0;i<objectList.size();i++) {
+		TuioObject *tobj = objectList[i];
+		tobj->getState(tstate);
+		objectAlive.push_back((int32)tstate.session_id);
+		if ((full_update) || (fullFrame) || (tobj->getTuioTime()==currentFrameTime)) objectStates.push_back(tstate);
+	}
 }
 
 void TuioServer::sendEmptyObjectBundle() {
@@ -519,43 +788,43 @@ void TuioServer::sendEmptyObjectBundle() {
 	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive" << osc::EndMessage;	
 	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "fseq" << -1 << osc::EndMessage;
 	(*oscPacket) << osc::EndBundle;
-	socket->Send( oscPacket->Data(), oscPacket->Size() );
+	oscPacket = frameBatch->queue();
 }
 
-void TuioServer::startObjectBundle() {
+void TuioServer::startObjectBundle(bool alive) {
 	oscPacket->Clear();	
 	(*oscPacket) << osc::BeginBundleImmediate;
 	
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive";
-	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
-		(*oscPacket) << (int32)((*tuioObject)->getSessionID());	
-	}
-	(*oscPacket) << osc::EndMessage;	
+	// compact frames only send the alive message with the first packet of a frame
+	if (!alive) return;
+	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "alive" << aliveArray(objectAlive) << osc::EndMessage;
 }
 
-void TuioServer::addObjectMessage(TuioObject *tobj) {
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "set";
-	(*oscPacket) << (int32)(tobj->getSessionID()) << tobj->getSymbolID() << tobj->getX() << tobj->getY() << tobj->getAngle();
-	(*oscPacket) << tobj->getXSpeed() << tobj->getYSpeed() << tobj->getRotationSpeed() << tobj->getMotionAccel() << tobj->getRotationAccel();	
-	(*oscPacket) << osc::EndMessage;
+void TuioServer::addObjectMessage(osc::OutboundPacketStream *packet, const TuioObjectState &tstate) {
+	int32 ints[2] = { (int32)tstate.session_id, (int32)tstate.symbol_id };
+	float floats[8] = { tstate.xpos, tstate.ypos, tstate.angle, tstate.x_speed, tstate.y_speed, tstate.rotation_speed, tstate.motion_accel, tstate.rotation_accel };
+	objectSetMessage.write(packet->ReserveMessage(objectSetMessage.getSize()),ints,floats);
 }
 
 void TuioServer::sendObjectBundle(long fseq) {
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "fseq" << (int32)fseq << osc::EndMessage;
+	int32 ints[1] = { (int32)fseq };
+	objectFseqMessage.write(oscPacket->ReserveMessage(objectFseqMessage.getSize()),ints,NULL);
 	(*oscPacket) << osc::EndBundle;
-	socket->Send( oscPacket->Data(), oscPacket->Size() );
+	frameBytes += oscPacket->Size();
+	frameDatagrams++;
+	oscPacket = frameBatch->queue();
 }
 
 TuioObject* TuioServer::getTuioObject(long s_id) {
-	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++)
-		if((*iter)->getSessionID()==s_id) return (*iter);
+	for (int i=0;i<objectList.size();i++)
+		if(objectList[i]->getSessionID()==s_id) return objectList[i];
 	
 	return NULL;
 }
 
 TuioCursor* TuioServer::getTuioCursor(long s_id) {
-	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++)
-		if((*iter)->getSessionID()==s_id) return (*iter);
+	for (int i=0;i<cursorList.size();i++)
+		if(cursorList[i]->getSessionID()==s_id) return cursorList[i];
 	
 	return NULL;
 }
@@ -565,10 +834,10 @@ TuioObject* TuioServer::getClosestTuioObject(float xp, float yp) {
 	TuioObject *closestObject = NULL;
 	float closestDistance = 1.0f;
 	
-	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++) {
-		float distance = (*iter)->getDistance(xp,yp);
+	for (int i=0;i<objectList.size();i++) {
+		float distance = objectList[i]->getDistance(xp,yp);
 		if(distance<closestDistance) {
-			closestObject = (*iter);
+			closestObject = objectList[i];
 			closestDistance = distance;
 		}
 	}
@@ -581,10 +850,10 @@ TuioCursor* TuioServer::getClosestTuioCursor(float xp, float yp, float zp) {
 	TuioCursor *closestCursor = NULL;
 	float closestDistance = 1.0f;
 
-	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++) {
-		float distance = (*iter)->getDistance(xp,yp,zp);
+	for (int i=0;i<cursorList.size();i++) {
+		float distance = cursorList[i]->getDistance(xp,yp,zp);
 		if(distance<closestDistance) {
-			closestCursor = (*iter);
+			closestCursor = cursorList[i];
 			closestDistance = distance;
 		}
 	}
@@ -593,18 +862,22 @@ TuioCursor* TuioServer::getClosestTuioCursor(float xp, float yp, float zp) {
 }
 
 std::list<TuioObject*> TuioServer::getTuioObjects() {
-	return objectList;
+	std::list<TuioObject*> objects;
+	for (int i=0;i<objectList.size();i++) objects.push_back(objectList[i]);
+	return objects;
 }
 
 std::list<TuioCursor*> TuioServer::getTuioCursors() {
-	return cursorList;
+	std::list<TuioCursor*> cursors;
+	for (int i=0;i<cursorList.size();i++) cursors.push_back(cursorList[i]);
+	return cursors;
 }
 
 std::list<TuioObject*> TuioServer::getUntouchedObjects() {
 	
 	std::list<TuioObject*> untouched;
-	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
-		TuioObject *tobj = (*tuioObject);
+	for (int i=0;i<objectList.size();i++) {
+		TuioObject *tobj = objectList[i];
 		if (tobj->getTuioTime()!=currentFrameTime) untouched.push_back(tobj);
 	}	
 	return untouched;
@@ -612,29 +885,23 @@ std::list<TuioObject*> TuioServer::getUntouchedObjects() {
 
 void TuioServer::stopUntouchedMovingObjects() {
 	
-	std::list<TuioObject*> untouched;
-	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
+	for (int i=0;i<objectList.size();i++) {
 		
-		TuioObject *tobj = (*tuioObject);
+		TuioObject *tobj = objectList[i];
 		if ((tobj->getTuioTime()!=currentFrameTime) && (tobj->isMoving())) {
 			tobj->stop(currentFrameTime);
 			updateObject = true;
-			if (verbose)		
-				std::cout << "set obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ") "<< tobj->getX() << " " << tobj->getY() << " " << tobj->getAngle() 
-				<< " " << tobj->getXSpeed() << " " << tobj->getYSpeed() << " " << tobj->getRotationSpeed() << " " << tobj->getMotionAccel() << " " << tobj->getRotationAccel() << std::endl;
+			if (verbose) logObject("set obj",tobj,true,true);
 		}
 	}
 }
 
 void TuioServer::removeUntouchedStoppedObjects() {
 	
-	std::list<TuioObject*>::iterator tuioObject = objectList.begin();
-	while (tuioObject!=objectList.end()) {
-		TuioObject *tobj = (*tuioObject);
-		if ((tobj->getTuioTime()!=currentFrameTime) && (!tobj->isMoving())) {
-			removeTuioObject(tobj);
-			tuioObject = objectList.begin();
-		} else tuioObject++;
+	// iterate backwards, since removing moves the last TuioObject into the free position
+	for (int i=objectList.size()-1;i>=0;i--) {
+		TuioObject *tobj = objectList[i];
+		if ((tobj->getTuioTime()!=currentFrameTime) && (!tobj->isMoving())) removeTuioObject(tobj);
 	}
 }
 
@@ -642,8 +909,8 @@ void TuioServer::removeUntouchedStoppedObjects() {
 std::list<TuioCursor*> TuioServer::getUntouchedCursors() {
 	
 	std::list<TuioCursor*> untouched;
-	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
-		TuioCursor *tcur = (*tuioCursor);
+	for (int i=0;i<cursorList.size();i++) {
+		TuioCursor *tcur = cursorList[i];
 		if (tcur->getTuioTime()!=currentFrameTime) untouched.push_back(tcur);
 	}	
 	return untouched;
@@ -651,21 +918,12 @@ std::list<TuioCursor*> TuioServer::getUntouchedCursors() {
 
 void TuioServer::stopUntouchedMovingCursors() {
 	
-	std::list<TuioCursor*> untouched;
-	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
-		TuioCursor *tcur = (*tuioCursor);
+	for (int i=0;i<cursorList.size();i++) {
+		TuioCursor *tcur = cursorList[i];
 		if ((tcur->getTuioTime()!=currentFrameTime) && (tcur->isMoving())) {
 			tcur->stop(currentFrameTime);
 			updateCursor = true;
-			if (verbose) {
-				if (mode3d) {
-					std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() << " " << tcur->getZ()
-					<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed()<< " " << tcur->getZSpeed()<< " " << tcur->getMotionAccel() << " " << std::endl;
-				} else {
-					std::cout << "set cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ") " << tcur->getX() << " " << tcur->getY() 
-					<< " " << tcur->getXSpeed() << " " << tcur->getYSpeed()<< " " << tcur->getMotionAccel() << " " << std::endl;
-				}
-			}
+			if (verbose) logCursor("set cur",tcur,true,true);
 		}
 	}	
 }
@@ -673,12 +931,9 @@ void TuioServer::stopUntouchedMovingCursors() {
 void TuioServer::removeUntouchedStoppedCursors() {
 	
 	if (cursorList.size()==0) return;
-	std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin();
-	while (tuioCursor!=cursorList.end()) {
-		TuioCursor *tcur = (*tuioCursor);
-		if ((tcur->getTuioTime()!=currentFrameTime) && (!tcur->isMoving())) {
-			removeTuioCursor(tcur);
-			tuioCursor = cursorList.begin();
-		} else tuioCursor++;
+	// iterate backwards, since removing moves the last TuioCursor into the free position
+	for (int i=cursorList.size()-1;i>=0;i--) {
+		TuioCursor *tcur = cursorList[i];
+		if ((tcur->getTuioTime()!=currentFrameTime) && (!tcur->isMoving())) removeTuioCursor(tcur);
 	}	
 }
@@ -35,6 +35,7 @@
 
 #include <iostream>
 #include <list>
+#include <vector>
 #include <algorithm>
 
 #include "osc/OscOutboundPacketStream.h"
@@ -43,14 +44,35 @@
 
 #include "TuioObject.h"
 #include "TuioCursor.h"
+#include "TuioPool.h"
+#include "TuioSlotMap.h"
+#include "TuioIdAllocator.h"
+#include "TuioMessageTemplate.h"
+#include "TuioDestinationList.h"
+#include "TuioPacketBatch.h"
+#include "TuioTripleBuffer.h"
+#include "TuioSharedMemory.h"
+#include "TuioStreamServer.h"
+#include "TuioLog.h"
 
 #define IP_MTU_SIZE 1500
 #define MAX_UDP_SIZE 65536
 #define MIN_UDP_SIZE 576
-#define OBJ_MESSAGE_SIZE 108	// setMessage + seqMessage size
-#define CUR_MESSAGE_SIZE 88 // TODO think about it!!
+#define INITIAL_CAPACITY 32	// preallocated cursors and objects
 
 namespace TUIO {
+	/**
+	 * The TuioFrameSnapshot structure holds the state of all TuioCursors and TuioObjects
+	 * at the end of a frame, which is handed over to the periodic full update thread.
+	 */
+	struct TuioFrameSnapshot {
+		std::vector<TuioCursorState> cursors;
+		std::vector<TuioObjectState> objects;
+		long aliveVersion;	// incremented with each frame adding or removing TuioCursors or TuioObjects
+
+		TuioFrameSnapshot():aliveVersion(0) {};
+	};
+
 	/**
 	 * <p>The TuioServer class is the central TUIO protocol encoder component.
 	 * In order to encode and send TUIO messages an instance of TuioServer needs to be created. The TuioServer instance then generates TUIO messaged
@@ -248,7 +270,21 @@ namespace TUIO {
 		DllExport TuioTime getFrameTime();
 
 		/**
-		 * Generates and sends TUIO messages of all currently active TuioObjects and TuioCursors.
+		 * Returns the number of bytes sent by the last call to commitFrame().
+		 * @return	the number of bytes sent for the last frame
+		 */
+		DllExport int getFrameBytes() { return frameBytes; }
+
+		/**
+		 * Returns the number of datagrams sent by the last call to commitFrame().
+		 * @return	the number of datagrams sent for the last frame
+		 */
+		DllExport int getFrameDatagrams() { return frameDatagrams; }
+
+		/**
+		 * Generates and sends TUIO messages of all TuioObjects and TuioCursors of the last committed frame.
+		 * The frame state is read from a snapshot, so this method may be called from another thread than the
+		 * one updating the frame, as long as only one thread at a time sends the full messages.
 		 */
 		DllExport void sendFullMessages();		
 
@@ -257,10 +293,23 @@ namespace TUIO {
 		 *
 		 * @param	interval	update interval in seconds, defaults to one second
 		 */
-		DllExport void enablePeriodicMessages(int interval=1);
+		DllExport void enablePeriodicMessages(int interval=1) { enablePeriodicMessagesMs(interval*MSEC_SECOND); }
+
+		/**
+		 * Enables the periodic full update of all currently active TuioObjects and TuioCursors with millisecond intervals,
+		 * or changes the intervals if the periodic full update is already enabled. The full updates are sent at
+		 * absolute deadlines, so the interval does not drift with the time it takes to send them.
+		 * If an adaptive interval is provided, the full updates are sent with the shorter adaptive interval for
+		 * one regular interval after each frame which added or removed TuioObjects or TuioCursors.
+		 *
+		 * @param	interval	update interval in milliseconds
+		 * @param	adaptiveInterval	update interval in milliseconds after adding or removing, zero disables the adaptive mode
+		 */
+		DllExport void enablePeriodicMessagesMs(int interval, int adaptiveInterval=0);
 
 		/**
 		 * Disables the periodic full update of all currently active and inactive TuioObjects and TuioCursors 
+		 * and waits until the periodic update thread has finished.
 		 */
 		DllExport void disablePeriodicMessages();
 
@@ -279,6 +328,59 @@ namespace TUIO {
 			full_update = false;
 		}
 		
+		/**
+		 * Enables delta updates, which only send set messages for TuioCursors whose position, speed or acceleration
+		 * differs by more than the provided epsilon from the values they have been sent with most recently.
+		 * The alive and fseq messages are still sent with every frame. Since a lost set message is not repeated
+		 * until the TuioCursor changes again, delta updates should be combined with periodic full updates.
+		 *
+		 * @param	epsilon	the largest difference which is considered unchanged
+		 */
+		DllExport void enableDeltaUpdate(float epsilon=0.0f) {
+			delta_epsilon = epsilon;
+			delta_update = true;
+		}
+
+		/**
+		 * Disables delta updates, all TuioCursors which have been updated within a frame are sent again.
+		 */
+		DllExport void disableDeltaUpdate() {
+			delta_update = false;
+		}
+
+		/**
+		 * Returns true if delta updates of TuioCursors are enabled.
+		 * @return	true if delta updates of TuioCursors are enabled
+		 */
+		DllExport bool deltaUpdateEnabled() {
+			return delta_update;
+		}
+
+		/**
+		 * Enables compact frames, which only send the alive message with the first packet of a frame that
+		 * needs to be split into several packets. This saves the repeated alive lists, but the continuation
+		 * packets are no longer self-contained as expected by TUIO 1.1, so this should only be enabled if
+		 * all receiving clients keep the alive list of the previous packet.
+		 */
+		DllExport void enableCompactFrames() {
+			compact_frames = true;
+		}
+
+		/**
+		 * Disables compact frames, the alive message is sent again with every packet.
+		 */
+		DllExport void disableCompactFrames() {
+			compact_frames = false;
+		}
+
+		/**
+		 * Returns true if compact frames are enabled.
+		 * @return	true if compact frames are enabled
+		 */
+		DllExport bool compactFramesEnabled() {
+			return compact_frames;
+		}
+		
 		/**
 		 * Returns true if the periodic full update of all currently active TuioObjects and TuioCursors is enabled.
 		 * @return	true if the periodic full update of all currently active TuioObjects and TuioCursors is enabled
@@ -292,8 +394,24 @@ namespace TUIO {
 		 * @return	the periodic update interval in seconds
 		 */
 		DllExport int getUpdateInterval() {
+			return update_interval/MSEC_SECOND;
+		}
+
+		/**
+		 * Returns the periodic update interval in milliseconds.
+		 * @return	the periodic update interval in milliseconds
+		 */
+		DllExport int getUpdateIntervalMs() {
 			return update_interval;
 		}
+
+		/**
+		 * Returns the adaptive periodic update interval in milliseconds, zero if the adaptive mode is disabled.
+		 * @return	the adaptive periodic update interval in milliseconds
+		 */
+		DllExport int getAdaptiveIntervalMs() {
+			return adaptive_interval;
+		}
 		
 		/**
 		 * Returns a List of all currently inactive TuioObjects
@@ -384,44 +502,166 @@ namespace TUIO {
 		
 		/**
 		 * The TuioServer prints verbose TUIO event messages to the console if set to true.
+		 * The messages are passed to the TuioLog at TUIO_LOG_INFO level and printed by its background thread.
 		 * @param	verbose	verbose message output if set to true
 		 */
 		DllExport void setVerbose(bool verbose) { this->verbose=verbose; }
 
 		//void set3d(bool mode3d) { this->mode3d=mode3d; }
 		DllExport bool isMode3d() { return mode3d; }
+
+		/**
+		 * Adds a receiver to which all following frames are sent as well.
+		 * Each frame is serialized only once and the same packets are sent to all destinations.
+		 *
+		 * @param	host	the receiving host name or unicast, broadcast or multicast address
+		 * @param	port	the receiving UDP port number
+		 * @return	false if the destination already has been added
+		 */
+		DllExport bool addDestination(const char *host, int port) { return destinations->add(host,port); }
+
+		/**
+		 * Removes a receiver, including the one provided to the constructor.
+		 *
+		 * @param	host	the receiving host name or address
+		 * @param	port	the receiving UDP port number
+		 * @return	false if the destination has not been added
+		 */
+		DllExport bool removeDestination(const char *host, int port) { return destinations->remove(host,port); }
+
+		/**
+		 * Returns the number of receivers.
+		 * @return	the number of receivers
+		 */
+		DllExport int getDestinationCount() { return destinations->size(); }
+
+		/**
+		 * Returns the endpoint and send statistics of the receiver at the provided position.
+		 *
+		 * @param	index	the position within 0..getDestinationCount()-1
+		 * @param	destination	the TuioDestination to fill
+		 * @return	false if there is no receiver at the provided position
+		 */
+		DllExport bool getDestination(int index, TuioDestination &destination) { return destinations->get(index,destination); }
+
+		/**
+		 * Additionally publishes the state of all TuioCursors and TuioObjects of each changed frame
+		 * to TuioClients on the same host through the shared memory segment with the provided name.
+		 * The UDP transport remains enabled.
+		 *
+		 * @param	name	the name of the shared memory segment, defaults to TUIO_SHM_NAME
+		 * @param	mode	the access mode of the shared memory segment, defaults to TUIO_SHM_MODE
+		 * @return	false if the shared memory segment could not be mapped
+		 */
+		DllExport bool enableSharedMemory(const char *name = TUIO_SHM_NAME, int mode = TUIO_SHM_MODE);
+
+		/**
+		 * Stops publishing frames to the shared memory segment.
+		 */
+		DllExport void disableSharedMemory();
+
+		/**
+		 * Additionally sends all frames to TuioClients connected to the provided TCP port,
+		 * using length-prefixed OSC packets. The UDP transport remains enabled.
+		 *
+		 * @param	port	the TCP port to listen to
+		 * @return	false if the port could not be bound
+		 */
+		DllExport bool listenTcp(int port);
+
+		/**
+		 * Additionally sends all frames to TuioClients connected to the Unix domain socket with the provided path,
+		 * using length-prefixed OSC packets. The UDP transport remains enabled.
+		 *
+		 * @param	path	the file system path of the socket
+		 * @return	false if the socket could not be bound
+		 */
+		DllExport bool listenUnix(const char *path);
+
+		/**
+		 * Returns the number of TuioClients connected through TCP or Unix domain sockets.
+		 * @return	the number of stream clients
+		 */
+		DllExport int getStreamClientCount() { return (stream!=NULL)?stream->getClientCount():0; }
 		
 	private:
-		std::list<TuioObject*> objectList;
-		std::list<TuioCursor*> cursorList;
+		TuioSlotMap<TuioObject> objectList;
+		TuioSlotMap<TuioCursor> cursorList;
+		TuioPool<TuioObject> objectPool;
+		TuioPool<TuioCursor> cursorPool;
+		
+		TuioIdAllocator cursorIdAllocator;
+		
+		std::vector<osc::int32> cursorAlive, objectAlive;
+		std::vector<TuioCursorState> cursorStates;
+		std::vector<TuioObjectState> objectStates;
+		TuioTripleBuffer<TuioFrameSnapshot> snapshots;
+		TuioSharedMemory *sharedMemory;
+		TuioStreamServer *stream;
+		bool fullFrame;
 		
-		int maxCursorID;
-		std::list<TuioCursor*> freeCursorList;
-		std::list<TuioCursor*> freeCursorBuffer;
+		TuioMessageTemplate<1,5> cursorSetMessage;
+		TuioMessageTemplate<1,7> cursor3dSetMessage;
+		TuioMessageTemplate<2,8> objectSetMessage;
+		TuioMessageTemplate<1,0> cursorFseqMessage, objectFseqMessage;
 		
-		UdpTransmitSocket *socket;	
+		UdpSocket *socket;
+		TuioDestinationList *destinations;
 		osc::OutboundPacketStream  *oscPacket;
-		char *oscBuffer; 
+		TuioPacketBatch *frameBatch;
 		osc::OutboundPacketStream  *fullPacket;
-		char *fullBuffer; 
+		TuioPacketBatch *fullBatch;
+		std::vector<osc::int32> fullAlive;
 		
 		void initialize(const char *host, int port, int size, bool mode3d = false);
+		
+		// the Session IDs of an alive message are appended at once
+		static osc::Int32Array aliveArray(const std::vector<osc::int32> &alive) {
+			return osc::Int32Array(alive.empty()?NULL:&alive[0],alive.size());
+		}
 
+		void updateCursorStates();
 		void sendEmptyCursorBundle();
-		void startCursorBundle();
-		void addCursorMessage(TuioCursor *tcur);
+		void startCursorBundle(bool alive);
+		void addCursorMessage(osc::OutboundPacketStream *packet, const TuioCursorState &tstate);
 		void sendCursorBundle(long fseq);
 		
+		void updateObjectStates();
 		void sendEmptyObjectBundle();
-		void startObjectBundle();
-		void addObjectMessage(TuioObject *tobj);
+		void startObjectBundle(bool alive);
+		void addObjectMessage(osc::OutboundPacketStream *packet, const TuioObjectState &tstate);
 		void sendObjectBundle(long fseq);
 		
+		void publishSnapshot();
+		
+		void logObject(const char *label, TuioObject *tobj, bool position, bool motion);
+		void logCursor(const char *label, TuioCursor *tcur, bool position, bool motion);
+		
+		void runPeriodicMessages();
+		void lockControl();
+		void unlockControl();
+		void lockPeriodic();
+		void unlockPeriodic();
+		void waitPeriodic(long long deadline);
+#ifndef WIN32
+		static void* periodicThreadFunc(void *obj);
+#else
+		static DWORD WINAPI periodicThreadFunc(LPVOID obj);
+#endif
+		
 		bool full_update;
+		bool delta_update;
+		float delta_epsilon;
+		bool compact_frames;
 		int update_interval;
+		int adaptive_interval;
+		int periodic_version;
 		bool periodic_update;
+		bool updateAlive;
+		long aliveVersion;
 
 		long currentFrame;
+		int frameBytes, frameDatagrams;
 		TuioTime currentFrameTime;
 		bool updateObject, updateCursor;
 		long lastCursorUpdate, lastObjectUpdate;
@@ -434,8 +674,14 @@ namespace TUIO {
 
 #ifndef WIN32
 		pthread_t thread;
+		pthread_mutex_t controlMutex;
+		pthread_mutex_t periodicMutex;
+		pthread_cond_t periodicCond;
 #else
 		HANDLE thread;
+		HANDLE controlMutex;
+		HANDLE periodicMutex;
+		HANDLE periodicEvent;
 #endif	
 		bool connected;
 	};
@@ -0,0 +1,200 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSESSIONMAP_H
+#define INCLUDED_TUIOSESSIONMAP_H
+
+#include <vector>
+#include <cstddef>
+
+#define TUIO_SESSION_MAP_CAPACITY 64	// initial number of buckets, needs to be a power of two
+
+namespace TUIO {
+
+	/**
+	 * The TuioSessionMap class maps Session IDs to TuioCursors or TuioObjects.
+	 * It is an open addressing hash table with linear probing, which keeps its load factor
+	 * below one half and removes elements by shifting the following elements back,
+	 * so no tombstones are left behind. Apart from growing the table neither insertion
+	 * nor removal allocate any memory. Each element also carries a stamp, which allows to
+	 * mark all elements of a frame and find the unmarked ones without any further set.
+	 *
+	 * @version 1.4
+	 */
+	template<class T> class TuioSessionMap {
+
+	private:
+		struct Bucket {
+			long session_id;
+			T *item;
+			unsigned int stamp;
+		};
+
+		std::vector<Bucket> buckets;
+		int count;
+
+		unsigned int mask() const {
+			return (unsigned int)buckets.size()-1;
+		}
+
+		// Session IDs are mostly consecutive, so they are scrambled to avoid long probe sequences
+		static unsigned int hash(long s_id) {
+			unsigned int h = (unsigned int)s_id * 2654435761U;
+			return h ^ (h>>16);
+		}
+
+		void grow() {
+			std::vector<Bucket> previous;
+			previous.swap(buckets);
+			Bucket empty = { 0, NULL, 0 };
+			buckets.assign(previous.size()*2, empty);
+			count = 0;
+			for (unsigned int i=0;i<previous.size();i++) {
+				if (previous[i].item!=NULL) {
+					insert(previous[i].session_id,previous[i].item);
+					setStamp(previous[i].session_id,previous[i].stamp);
+				}
+			}
+		}
+
+	public:
+		/**
+		 * The default constructor creates an empty TuioSessionMap with TUIO_SESSION_MAP_CAPACITY buckets.
+		 */
+		TuioSessionMap():count(0) {
+			Bucket empty = { 0, NULL, 0 };
+			buckets.assign(TUIO_SESSION_MAP_CAPACITY, empty);
+		};
+
+		/**
+		 * Returns the element with the provided Session ID or NULL if there is no such element.
+		 *
+		 * @param	s_id	the Session ID of the element
+		 * @return	the element or NULL
+		 */
+		T* find(long s_id) const {
+			for (unsigned int i=hash(s_id)&mask();buckets[i].item!=NULL;i=(i+1)&mask()) {
+				if (buckets[i].session_id==s_id) return buckets[i].item;
+			}
+			return NULL;
+		};
+
+		/**
+		 * Adds the provided element or replaces the element with the same Session ID.
+		 *
+		 * @param	s_id	the Session ID of the element
+		 * @param	item	the element to add, which must not be NULL
+		 */
+		void insert(long s_id, T *item) {
+			if ((count+1)*2>(int)buckets.size()) grow();
+
+			unsigned int i = hash(s_id)&mask();
+			while (buckets[i].item!=NULL) {
+				if (buckets[i].session_id==s_id) {
+					buckets[i].item = item;
+					return;
+				}
+				i = (i+1)&mask();
+			}
+			buckets[i].session_id = s_id;
+			buckets[i].item = item;
+			buckets[i].stamp = 0;
+			count++;
+		};
+
+		/**
+		 * Assigns the provided stamp to the element with the provided Session ID.
+		 *
+		 * @param	s_id	the Session ID of the element
+		 * @param	stamp	the stamp to assign
+		 * @return	true if there is such an element and it did not carry the provided stamp already
+		 */
+		bool setStamp(long s_id, unsigned int stamp) {
+			for (unsigned int i=hash(s_id)&mask();buckets[i].item!=NULL;i=(i+1)&mask()) {
+				if (buckets[i].session_id==s_id) {
+					if (buckets[i].stamp==stamp) return false;
+					buckets[i].stamp = stamp;
+					return true;
+				}
+			}
+			return false;
+		};
+
+		/**
+		 * Returns true if the element with the provided Session ID carries the provided stamp.
+		 *
+		 * @param	s_id	the Session ID of the element
+		 * @param	stamp	the stamp to compare
+		 * @return	true if there is such an element and it carries the provided stamp
+		 */
+		bool hasStamp(long s_id, unsigned int stamp) const {
+			for (unsigned int i=hash(s_id)&mask();buckets[i].item!=NULL;i=(i+1)&mask()) {
+				if (buckets[i].session_id==s_id) return (buckets[i].stamp==stamp);
+			}
+			return false;
+		};
+
+		/**
+		 * Removes the element with the provided Session ID.
+		 *
+		 * @param	s_id	the Session ID of the element to remove
+		 * @return	true if there was such an element
+		 */
+		bool remove(long s_id) {
+			unsigned int i = hash(s_id)&mask();
+			while (buckets[i].session_id!=s_id) {
+				if (buckets[i].item==NULL) return false;
+				i = (i+1)&mask();
+			}
+			if (buckets[i].item==NULL) return false;
+
+			// move following elements of the probe sequence into the gap
+			unsigned int gap = i;
+			for (unsigned int j=(i+1)&mask();buckets[j].item!=NULL;j=(j+1)&mask()) {
+				unsigned int home = hash(buckets[j].session_id)&mask();
+				if (((j-home)&mask())>=((j-gap)&mask())) {
+					buckets[gap] = buckets[j];
+					gap = j;
+				}
+			}
+			buckets[gap].item = NULL;
+			count--;
+			return true;
+		};
+
+		/**
+		 * Removes all elements.
+		 */
+		void clear() {
+			for (unsigned int i=0;i<buckets.size();i++) buckets[i].item = NULL;
+			count = 0;
+		};
+
+		/**
+		 * Returns the number of present elements.
+		 * @return	the number of present elements
+		 */
+		int size() const {
+			return count;
+		};
+	};
+};
+#endif /* INCLUDED_TUIOSESSIONMAP_H */
@@ -0,0 +1,233 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioSharedMemory.h"
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+#endif
+
+using namespace TUIO;
+
+#define TUIO_SHM_MAGIC 0x5455494F	// 'TUIO'
+#define TUIO_SHM_RETRIES 100	// gives up on a frame which is never completed by a crashed server
+
+namespace TUIO {
+
+	struct TuioSharedFrame {
+		volatile unsigned int sequence;	// odd while the frame is being written
+		int fseq;
+		int cursorCount;
+		int objectCount;
+		int truncated;	// TUIO_SHM_CURSORS_TRUNCATED and TUIO_SHM_OBJECTS_TRUNCATED
+		TuioCursorState cursors[TUIO_SHM_MAX_CURSORS];
+		TuioObjectState objects[TUIO_SHM_MAX_OBJECTS];
+	};
+
+	struct TuioSharedHeader {
+		volatile unsigned int magic;
+		volatile unsigned int layout;	// the frame size, which differs between incompatible builds
+		volatile unsigned int frameCount;	// the most recent frame is stored in slot (frameCount-1)%TUIO_SHM_SLOTS
+		volatile int waiting;	// set by readers before they are going to sleep
+		TuioSharedFrame frames[TUIO_SHM_SLOTS];
+	};
+};
+
+static void memoryBarrier() {
+#ifdef WIN32
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+TuioSharedMemory::TuioSharedMemory(TuioSharedHeader *shm, bool write):header(shm),writer(write) {
+	// a new reader starts with the most recent frame
+	unsigned int count = header->frameCount;
+	lastFrame = (count>0)?count-1:0;
+}
+
+TuioSharedHeader* TuioSharedMemory::map(const char *name, int mode, bool write) {
+#ifndef WIN32
+	int fd = shm_open(name, O_RDWR | O_CREAT, (mode_t)mode);
+	if (fd<0) return NULL;
+
+	// both the server and the clients may create the segment, whoever comes first
+	struct stat st;
+	if ((fstat(fd,&st)<0) || ((st.st_size<(off_t)sizeof(TuioSharedHeader)) && (ftruncate(fd,sizeof(TuioSharedHeader))<0))) {
+		close(fd);
+		return NULL;
+	}
+
+	// the server does not publish into a segment another user may have prepared,
+	// and restricts the access mode of a segment created with a different mode
+	if (write) {
+		if ((st.st_uid!=geteuid()) || (((st.st_mode&0777)!=(mode_t)mode) && (fchmod(fd,(mode_t)mode)<0))) {
+			close(fd);
+			return NULL;
+		}
+	}
+
+	void *shm = mmap(NULL, sizeof(TuioSharedHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (shm==MAP_FAILED) return NULL;
+	return static_cast<TuioSharedHeader*>(shm);
+#else
+	return NULL;
+#endif
+}
+
+TuioSharedMemory* TuioSharedMemory::createWriter(const char *name, int mode) {
+	TuioSharedHeader *shm = map(name,mode,true);
+	if (shm==NULL) {
+		std::cerr << "could not map shared memory " << name << std::endl;
+		return NULL;
+	}
+
+	if ((shm->magic!=TUIO_SHM_MAGIC) || (shm->layout!=sizeof(TuioSharedFrame))) {
+		shm->layout = sizeof(TuioSharedFrame);
+		memoryBarrier();
+		shm->magic = TUIO_SHM_MAGIC;
+	}
+	return new TuioSharedMemory(shm,true);
+}
+
+TuioSharedMemory* TuioSharedMemory::createReader(const char *name, int mode) {
+	TuioSharedHeader *shm = map(name,mode,false);
+	if (shm==NULL) {
+		std::cerr << "could not map shared memory " << name << std::endl;
+		return NULL;
+	}
+	return new TuioSharedMemory(shm,false);
+}
+
+TuioSharedMemory::~TuioSharedMemory() {
+#ifndef WIN32
+	munmap(header, sizeof(TuioSharedHeader));
+#endif
+}
+
+void TuioSharedMemory::write(long fseq, const TuioCursorState *cursors, int cursorCount, const TuioObjectState *objects, int objectCount) {
+	if (!writer) return;
+	int truncated = 0;
+	if (cursorCount>TUIO_SHM_MAX_CURSORS) {
+		cursorCount = TUIO_SHM_MAX_CURSORS;
+		truncated |= TUIO_SHM_CURSORS_TRUNCATED;
+	}
+	if (objectCount>TUIO_SHM_MAX_OBJECTS) {
+		objectCount = TUIO_SHM_MAX_OBJECTS;
+		truncated |= TUIO_SHM_OBJECTS_TRUNCATED;
+	}
+
+	unsigned int count = header->frameCount;
+	TuioSharedFrame *frame = &header->frames[count%TUIO_SHM_SLOTS];
+
+	frame->sequence++;
+	memoryBarrier();
+	frame->fseq = (int)fseq;
+	frame->cursorCount = cursorCount;
+	frame->objectCount = objectCount;
+	frame->truncated = truncated;
+	if (cursorCount>0) memcpy(frame->cursors, cursors, cursorCount*sizeof(TuioCursorState));
+	if (objectCount>0) memcpy(frame->objects, objects, objectCount*sizeof(TuioObjectState));
+	memoryBarrier();
+	frame->sequence++;
+
+	memoryBarrier();
+	header->frameCount = count+1;
+	memoryBarrier();
+
+	if (header->waiting) {
+		header->waiting = 0;
+#ifdef __linux__
+		syscall(SYS_futex, &header->frameCount, FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0);
+#endif
+	}
+}
+
+bool TuioSharedMemory::wait(int timeout) {
+	if (header->frameCount!=lastFrame) return true;
+
+#if defined(__linux__)
+	unsigned int count = lastFrame;
+	header->waiting = 1;
+	memoryBarrier();
+	if (header->frameCount==count) {
+		struct timespec ts;
+		ts.tv_sec = timeout/MSEC_SECOND;
+		ts.tv_nsec = (timeout%MSEC_SECOND)*NSEC_MILLISECOND;
+		syscall(SYS_futex, &header->frameCount, FUTEX_WAIT, count, &ts, NULL, 0);
+	}
+#elif !defined(WIN32)
+	for (int i=0;(i<timeout) && (header->frameCount==lastFrame);i++) usleep(USEC_MILLISECOND);
+#endif
+	return (header->frameCount!=lastFrame);
+}
+
+bool TuioSharedMemory::read(long &fseq, std::vector<TuioCursorState> &cursors, std::vector<TuioObjectState> &objects, int &truncated) {
+	if ((header->magic!=TUIO_SHM_MAGIC) || (header->layout!=sizeof(TuioSharedFrame))) {
+		lastFrame = header->frameCount;
+		return false;
+	}
+
+	for (int retry=0;retry<TUIO_SHM_RETRIES;retry++) {
+		unsigned int count = header->frameCount;
+		if (count==lastFrame) return false;
+		memoryBarrier();
+
+		const TuioSharedFrame *frame = &header->frames[(count-1)%TUIO_SHM_SLOTS];
+		unsigned int sequence = frame->sequence;
+		if (sequence & 1) continue;
+		memoryBarrier();
+
+		int cursorCount = frame->cursorCount;
+		int objectCount = frame->objectCount;
+		if ((cursorCount<0) || (cursorCount>TUIO_SHM_MAX_CURSORS) || (objectCount<0) || (objectCount>TUIO_SHM_MAX_OBJECTS)) continue;
+
+		fseq = frame->fseq;
+		truncated = frame->truncated;
+		cursors.resize(cursorCount);
+		if (cursorCount>0) memcpy(&cursors[0], frame->cursors, cursorCount*sizeof(TuioCursorState));
+		objects.resize(objectCount);
+		if (objectCount>0) memcpy(&objects[0], frame->objects, objectCount*sizeof(TuioObjectState));
+
+		// retry if the server has started to overwrite the frame while it was copied
+		memoryBarrier();
+		if (frame->sequence!=sequence) continue;
+
+		lastFrame = count;
+		return true;
+	}
+	
+	lastFrame = header->frameCount;
+	return false;
+}
@@ -0,0 +1,127 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSHAREDMEMORY_H
+#define INCLUDED_TUIOSHAREDMEMORY_H
+
+#include <vector>
+#include "TuioCursor.h"
+#include "TuioObject.h"
+
+#define TUIO_SHM_NAME "/tuio"
+#define TUIO_SHM_SLOTS 4
+#define TUIO_SHM_MAX_CURSORS 256
+#define TUIO_SHM_MAX_OBJECTS 256
+#define TUIO_SHM_MODE 0600	// access mode of the shared memory segment, only the owner may read or write frames
+
+#define TUIO_SHM_CURSORS_TRUNCATED 1
+#define TUIO_SHM_OBJECTS_TRUNCATED 2
+
+namespace TUIO {
+
+	struct TuioSharedFrame;
+	struct TuioSharedHeader;
+
+	/**
+	 * The TuioSharedMemory class is a TUIO transport for clients running on the same host as the TuioServer.
+	 * The server writes the state of all TuioCursors and TuioObjects of each frame into a ring of frame slots
+	 * within a POSIX shared memory segment, each of which is protected by a sequence lock, so the server
+	 * never waits for any client. Clients copy the most recent frame straight out of the shared memory
+	 * and retry if the server has overwritten it in the meantime, without any OSC encoding or socket calls.
+	 * On Linux waiting clients are woken up with a futex, elsewhere they poll once per millisecond.
+	 * Frames holding more than TUIO_SHM_MAX_CURSORS cursors or TUIO_SHM_MAX_OBJECTS objects are truncated
+	 * and flagged as such, so that readers can keep their previous state instead of removing the missing ones.
+	 *
+	 * @version 1.4
+	 */
+	class TuioSharedMemory {
+
+	private:
+		TuioSharedHeader *header;
+		bool writer;
+		unsigned int lastFrame;
+
+		TuioSharedMemory(TuioSharedHeader *shm, bool write);
+		TuioSharedMemory(const TuioSharedMemory&);
+		TuioSharedMemory& operator=(const TuioSharedMemory&);
+
+		static TuioSharedHeader* map(const char *name, int mode, bool write);
+
+	public:
+		/**
+		 * Creates or opens the shared memory segment with the provided name for writing frames.
+		 * The access mode is applied to the segment unless it has been created by another user,
+		 * in which case it is not used at all.
+		 *
+		 * @param	name	the name of the shared memory segment, such as /tuio
+		 * @param	mode	the access mode of the segment, such as 0600 or 0660
+		 * @return	the TuioSharedMemory or NULL if the segment could not be mapped
+		 */
+		static TuioSharedMemory* createWriter(const char *name = TUIO_SHM_NAME, int mode = TUIO_SHM_MODE);
+
+		/**
+		 * Creates or opens the shared memory segment with the provided name for reading frames.
+		 * The segment may be created before the TuioServer starts writing to it.
+		 *
+		 * @param	name	the name of the shared memory segment, such as /tuio
+		 * @param	mode	the access mode if the segment is created, such as 0600 or 0660
+		 * @return	the TuioSharedMemory or NULL if the segment could not be mapped
+		 */
+		static TuioSharedMemory* createReader(const char *name = TUIO_SHM_NAME, int mode = TUIO_SHM_MODE);
+
+		/**
+		 * The destructor unmaps the shared memory segment, which remains available for
+		 * the other processes, so clients keep working across server restarts.
+		 */
+		~TuioSharedMemory();
+
+		/**
+		 * Writes a complete frame and wakes up all waiting readers.
+		 *
+		 * @param	fseq	the frame ID
+		 * @param	cursors	the state of all TuioCursors
+		 * @param	cursorCount	the number of TuioCursors
+		 * @param	objects	the state of all TuioObjects
+		 * @param	objectCount	the number of TuioObjects
+		 */
+		void write(long fseq, const TuioCursorState *cursors, int cursorCount, const TuioObjectState *objects, int objectCount);
+
+		/**
+		 * Waits until a frame has been written which has not been read yet.
+		 *
+		 * @param	timeout	the maximum time to wait in milliseconds
+		 * @return	true if an unread frame is available
+		 */
+		bool wait(int timeout);
+
+		/**
+		 * Copies the most recent frame if it has not been read yet, skipping any older unread frames.
+		 *
+		 * @param	fseq	receives the frame ID
+		 * @param	cursors	receives the state of all TuioCursors
+		 * @param	objects	receives the state of all TuioObjects
+		 * @param	truncated	receives TUIO_SHM_CURSORS_TRUNCATED and TUIO_SHM_OBJECTS_TRUNCATED for incomplete lists
+		 * @return	true if an unread frame has been copied
+		 */
+		bool read(long &fseq, std::vector<TuioCursorState> &cursors, std::vector<TuioObjectState> &objects, int &truncated);
+	};
+};
+#endif /* INCLUDED_TUIOSHAREDMEMORY_H */
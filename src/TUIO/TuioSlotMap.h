@@ -0,0 +1,167 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSLOTMAP_H
+#define INCLUDED_TUIOSLOTMAP_H
+
+#include <vector>
+#include <cstddef>
+
+#define TUIO_INVALID_SLOT 0xffffffffffffffffULL
+
+namespace TUIO {
+
+	/**
+	 * The TuioSlotMap class stores references to TuioCursors or TuioObjects in a contiguous array.
+	 * Every inserted element is identified by a generation tagged handle, which allows constant time
+	 * lookup and removal, while stale handles of already removed elements are safely rejected.
+	 * Removing an element moves the last element into the free position, therefore the iteration
+	 * order is not stable across removals. Apart from growing beyond the reserved capacity
+	 * neither insertion nor removal allocate any memory.
+	 *
+	 * @version 1.4
+	 */
+	template<class T> class TuioSlotMap {
+
+	private:
+		struct Slot {
+			unsigned int index;
+			unsigned int generation;
+		};
+
+		std::vector<T*> items;
+		std::vector<unsigned int> itemSlots;
+		std::vector<Slot> slots;
+		std::vector<unsigned int> freeSlots;
+
+		static unsigned long long makeHandle(unsigned int slot, unsigned int generation) {
+			return ((unsigned long long)generation<<32) | (unsigned long long)slot;
+		}
+
+	public:
+		/**
+		 * Makes sure that the provided number of elements can be stored without any further heap allocations.
+		 *
+		 * @param	count	the number of elements to reserve space for
+		 */
+		void reserve(int count) {
+			items.reserve(count);
+			itemSlots.reserve(count);
+			slots.reserve(count);
+			freeSlots.reserve(count);
+		};
+
+		/**
+		 * Adds the provided element and returns its handle.
+		 *
+		 * @param	item	the element to add
+		 * @return	the handle of the added element
+		 */
+		unsigned long long insert(T *item) {
+			unsigned int slot;
+			if (freeSlots.size()>0) {
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			} else {
+				slot = (unsigned int)slots.size();
+				Slot s;
+				s.generation = 0;
+				slots.push_back(s);
+			}
+
+			slots[slot].index = (unsigned int)items.size();
+			items.push_back(item);
+			itemSlots.push_back(slot);
+			return makeHandle(slot,slots[slot].generation);
+		};
+
+		/**
+		 * Returns the element referenced by the provided handle
+		 * or NULL if the handle does not refer to a present element.
+		 *
+		 * @param	handle	the handle of the element
+		 * @return	the referenced element or NULL
+		 */
+		T* get(unsigned long long handle) const {
+			unsigned int slot = (unsigned int)(handle & 0xffffffffULL);
+			if (slot>=slots.size()) return NULL;
+			if (slots[slot].generation!=(unsigned int)(handle>>32)) return NULL;
+			return items[slots[slot].index];
+		};
+
+		/**
+		 * Removes the element referenced by the provided handle.
+		 *
+		 * @param	handle	the handle of the element to remove
+		 * @return	true if the handle referred to a present element
+		 */
+		bool remove(unsigned long long handle) {
+			unsigned int slot = (unsigned int)(handle & 0xffffffffULL);
+			if (slot>=slots.size()) return false;
+			if (slots[slot].generation!=(unsigned int)(handle>>32)) return false;
+
+			unsigned int index = slots[slot].index;
+			unsigned int last = (unsigned int)items.size()-1;
+			if (index!=last) {
+				items[index] = items[last];
+				itemSlots[index] = itemSlots[last];
+				slots[itemSlots[index]].index = index;
+			}
+			items.pop_back();
+			itemSlots.pop_back();
+
+			slots[slot].generation++;
+			freeSlots.push_back(slot);
+			return true;
+		};
+
+		/**
+		 * Removes all elements and invalidates all handles.
+		 */
+		void clear() {
+			for (unsigned int i=0;i<itemSlots.size();i++) {
+				slots[itemSlots[i]].generation++;
+				freeSlots.push_back(itemSlots[i]);
+			}
+			items.clear();
+			itemSlots.clear();
+		};
+
+		/**
+		 * Returns the number of present elements.
+		 * @return	the number of present elements
+		 */
+		int size() const {
+			return (int)items.size();
+		};
+
+		/**
+		 * Returns the element at the provided position of the contiguous element array.
+		 *
+		 * @param	index	the position within 0..size()-1
+		 * @return	the element at the provided position
+		 */
+		T* operator[](int index) const {
+			return items[index];
+		};
+	};
+};
+#endif /* INCLUDED_TUIOSLOTMAP_H */
@@ -0,0 +1,148 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSNAPSHOTPOOL_H
+#define INCLUDED_TUIOSNAPSHOTPOOL_H
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#define TUIO_SNAPSHOT_POOL 8	// number of snapshots, limits the snapshots which can be held at the same time
+
+namespace TUIO {
+
+	/**
+	 * The TuioSnapshotPool class passes immutable snapshots from a single writer thread to any number
+	 * of reader threads without any locks. Readers acquire the most recently published snapshot,
+	 * which remains unchanged until they release it again, and the writer only reuses snapshots
+	 * which are neither published nor held by any reader. If all snapshots are held,
+	 * the writer can not claim a snapshot and the previously published one remains current.
+	 * <p><code>
+	 * T *snapshot = pool.claim();<br/>
+	 * if (snapshot!=NULL) { ... pool.publish(snapshot); }<br/>
+	 * ...<br/>
+	 * const T *current = pool.acquire();<br/>
+	 * ...<br/>
+	 * pool.release(current);<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	template<class T> class TuioSnapshotPool {
+
+	private:
+		enum { WRITING = 0x40000000 };
+
+		T snapshots[TUIO_SNAPSHOT_POOL];
+		volatile long references[TUIO_SNAPSHOT_POOL];
+		volatile long current;
+
+		static long load(volatile long *value) {
+#ifdef WIN32
+			return InterlockedCompareExchange(value, 0, 0);
+#else
+			return __sync_fetch_and_or(value, 0);
+#endif
+		}
+
+		static long add(volatile long *value, long amount) {
+#ifdef WIN32
+			return InterlockedExchangeAdd(value, amount)+amount;
+#else
+			return __sync_add_and_fetch(value, amount);
+#endif
+		}
+
+		static bool compareAndSwap(volatile long *value, long expected, long desired) {
+#ifdef WIN32
+			return (InterlockedCompareExchange(value, desired, expected)==expected);
+#else
+			return __sync_bool_compare_and_swap(value, expected, desired);
+#endif
+		}
+
+		TuioSnapshotPool(const TuioSnapshotPool&);
+		TuioSnapshotPool& operator=(const TuioSnapshotPool&);
+
+	public:
+		/**
+		 * The default constructor publishes the first of the default constructed snapshots.
+		 */
+		TuioSnapshotPool():current(0) {
+			for (int i=0;i<TUIO_SNAPSHOT_POOL;i++) references[i] = 0;
+		};
+
+		/**
+		 * Returns a snapshot which may be modified by the writer thread until it is published,
+		 * or NULL if all snapshots are held by readers. Its content is left over from an earlier snapshot.
+		 * @return	the claimed snapshot or NULL
+		 */
+		T* claim() {
+			long published = load(&current);
+			for (int i=0;i<TUIO_SNAPSHOT_POOL;i++) {
+				if ((i!=published) && (compareAndSwap(&references[i], 0, -WRITING))) return &snapshots[i];
+			}
+			return NULL;
+		};
+
+		/**
+		 * Publishes the provided claimed snapshot, which must not be modified anymore.
+		 *
+		 * @param	snapshot	the claimed snapshot
+		 */
+		void publish(T *snapshot) {
+			long index = (long)(snapshot-snapshots);
+			add(&references[index], WRITING);
+
+			long previous;
+			do {
+				previous = load(&current);
+			} while (!compareAndSwap(&current, previous, index));
+		};
+
+		/**
+		 * Returns the most recently published snapshot, which remains valid and unchanged until it is released.
+		 * @return	the most recently published snapshot
+		 */
+		const T* acquire() {
+			for (;;) {
+				long index = load(&current);
+				add(&references[index], 1);
+
+				// the snapshot might have been replaced and claimed again in the meantime
+				if (load(&current)==index) return &snapshots[index];
+				add(&references[index], -1);
+			}
+		};
+
+		/**
+		 * Releases the provided acquired snapshot.
+		 *
+		 * @param	snapshot	the acquired snapshot
+		 */
+		void release(const T *snapshot) {
+			if (snapshot==NULL) return;
+			add(&references[snapshot-snapshots], -1);
+		};
+	};
+};
+#endif /* INCLUDED_TUIOSNAPSHOTPOOL_H */
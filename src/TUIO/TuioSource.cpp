@@ -0,0 +1,49 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioSource.h"
+#include "TuioClient.h"
+#include <string.h>
+
+using namespace TUIO;
+
+TuioSource::TuioSource(TuioClient *tclient, int idx, const char *sname, float sx, float sy, float ox, float oy)
+: client      (tclient)
+, socket      (NULL)
+, index       (idx)
+, scaleX      (sx)
+, scaleY      (sy)
+, offsetX     (ox)
+, offsetY     (oy)
+, currentFrame(-1)
+{
+	strncpy(name, sname, TUIO_SOURCE_NAME-1);
+	name[TUIO_SOURCE_NAME-1] = '\0';
+}
+
+TuioSource::~TuioSource() {
+	delete socket;
+}
+
+// packets received on the port of this source are processed as sent by this source
+void TuioSource::ProcessPacket( const char *data, int size, const IpEndpointName &remoteEndpoint ) {
+	client->processSourcePacket(this, data, size, remoteEndpoint);
+}
@@ -0,0 +1,110 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSOURCE_H
+#define INCLUDED_TUIOSOURCE_H
+
+#include "osc/OscTypes.h"
+#include "ip/UdpSocket.h"
+#include "ip/PacketListener.h"
+
+#define TUIO_MAX_SOURCES 16		// maximum number of sources a TuioClient merges
+#define TUIO_SOURCE_NAME 64		// maximum length of a source name
+
+namespace TUIO {
+
+	class TuioClient;
+
+	/**
+	 * The TuioSource class represents one of the TUIO servers whose TuioCursors and TuioObjects a TuioClient merges.
+	 * A source is either identified by the UDP port it sends to, by the name of its source message,
+	 * or otherwise by the address and port it sends from. The Session IDs of each source are namespaced
+	 * by multiplying them with TUIO_MAX_SOURCES and adding the index of the source, and its coordinates
+	 * are scaled and offset into the space shared by all sources.
+	 *
+	 * @version 1.4
+	 */
+	class TuioSource : public PacketListener {
+
+		friend class TuioClient;
+
+	private:
+		TuioClient *client;
+		UdpReceiveSocket *socket;
+		char name[TUIO_SOURCE_NAME];
+		int index;
+		float scaleX, scaleY;
+		float offsetX, offsetY;
+		osc::int32 currentFrame;
+
+		TuioSource(TuioClient *tclient, int idx, const char *sname, float sx, float sy, float ox, float oy);
+		~TuioSource();
+		TuioSource(const TuioSource&);
+		TuioSource& operator=(const TuioSource&);
+
+	public:
+		/**
+		 * Returns the name of this TuioSource, which is either its source message, its address and port or its UDP port.
+		 * @return	the name of this TuioSource
+		 */
+		const char* getName() const { return name; }
+
+		/**
+		 * Returns the index of this TuioSource within its TuioClient.
+		 * @return	the index of this TuioSource
+		 */
+		int getIndex() const { return index; }
+
+		/**
+		 * Returns the namespaced Session ID for the provided Session ID of this TuioSource.
+		 *
+		 * @param	s_id	the Session ID received from this TuioSource
+		 * @return	the Session ID within the TuioClient
+		 */
+		long getSessionID(long s_id) const { return s_id*TUIO_MAX_SOURCES+index; }
+
+		/**
+		 * Returns true if the provided namespaced Session ID belongs to this TuioSource.
+		 *
+		 * @param	s_id	the Session ID within the TuioClient
+		 * @return	true if the Session ID belongs to this TuioSource
+		 */
+		bool ownsSessionID(long s_id) const { return ((s_id%TUIO_MAX_SOURCES)==index); }
+
+		/**
+		 * Transforms the provided position and velocity into the shared space.
+		 *
+		 * @param	x	the X coordinate to transform
+		 * @param	y	the Y coordinate to transform
+		 * @param	xspeed	the X velocity to transform
+		 * @param	yspeed	the Y velocity to transform
+		 */
+		void transform(float &x, float &y, float &xspeed, float &yspeed) const {
+			x = x*scaleX+offsetX;
+			y = y*scaleY+offsetY;
+			xspeed *= scaleX;
+			yspeed *= scaleY;
+		}
+
+		void ProcessPacket( const char *data, int size, const IpEndpointName &remoteEndpoint );
+	};
+};
+#endif /* INCLUDED_TUIOSOURCE_H */
@@ -0,0 +1,142 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioStreamReceiver.h"
+#include "ip/NetworkingUtils.h"
+#include <iostream>
+#include <string.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+using namespace TUIO;
+
+#define RECEIVE_SIZE 65536
+
+TuioStreamReceiver::TuioStreamReceiver(int fd, const IpEndpointName &remote):socketFD(fd),endpoint(remote) {
+	buffer.reserve(RECEIVE_SIZE);
+}
+
+TuioStreamReceiver* TuioStreamReceiver::connectTcp(const char *host, int port) {
+#ifndef WIN32
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd<0) return NULL;
+
+	IpEndpointName remote(GetHostByName(host),port);
+	struct sockaddr_in addr;
+	memset(&addr,0,sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(remote.address);
+	addr.sin_port = htons(port);
+	if (connect(fd,(struct sockaddr*)&addr,sizeof(addr))<0) {
+		std::cerr << "could not connect to TCP port " << port << " of " << host << std::endl;
+		close(fd);
+		return NULL;
+	}
+
+	int on = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	return new TuioStreamReceiver(fd,remote);
+#else
+	return NULL;
+#endif
+}
+
+TuioStreamReceiver* TuioStreamReceiver::connectUnix(const char *path) {
+#ifndef WIN32
+	struct sockaddr_un addr;
+	if (strlen(path)>=sizeof(addr.sun_path)) return NULL;
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd<0) return NULL;
+
+	memset(&addr,0,sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path,path);
+	if (connect(fd,(struct sockaddr*)&addr,sizeof(addr))<0) {
+		std::cerr << "could not connect to Unix socket " << path << std::endl;
+		close(fd);
+		return NULL;
+	}
+	return new TuioStreamReceiver(fd,IpEndpointName());
+#else
+	return NULL;
+#endif
+}
+
+TuioStreamReceiver::~TuioStreamReceiver() {
+#ifndef WIN32
+	close(socketFD);
+#endif
+}
+
+void TuioStreamReceiver::Run(PacketListener *listener) {
+#ifndef WIN32
+	int start = 0;
+	int end = 0;
+	buffer.resize(RECEIVE_SIZE);
+
+	for (;;) {
+		// parse all complete packets, each of which is preceded by its big-endian size
+		while (end-start>=4) {
+			const unsigned char *prefix = (const unsigned char*)&buffer[start];
+			unsigned int size = (prefix[0]<<24) | (prefix[1]<<16) | (prefix[2]<<8) | prefix[3];
+			if (size>TUIO_STREAM_MAX_PACKET) {
+				std::cerr << "invalid TUIO stream packet size " << size << std::endl;
+				return;
+			}
+			if (end-start<4+(int)size) {
+				if (4+(int)size>(int)buffer.size()) buffer.resize(4+size);
+				break;
+			}
+			if (size>0) listener->ProcessPacket(&buffer[start+4],(int)size,endpoint);
+			start += 4+size;
+		}
+
+		// move the incomplete packet to the front of the buffer
+		if (start>0) {
+			if (end>start) memmove(&buffer[0],&buffer[start],end-start);
+			end -= start;
+			start = 0;
+		}
+
+		int result = recv(socketFD, &buffer[end], buffer.size()-end, 0);
+		if (result<0) {
+			if (errno==EINTR) continue;
+			return;
+		}
+		if (result==0) return;
+		end += result;
+	}
+#endif
+}
+
+void TuioStreamReceiver::Break() {
+#ifndef WIN32
+	shutdown(socketFD, SHUT_RDWR);
+#endif
+}
@@ -0,0 +1,86 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSTREAMRECEIVER_H
+#define INCLUDED_TUIOSTREAMRECEIVER_H
+
+#include <vector>
+#include "ip/PacketListener.h"
+#include "ip/IpEndpointName.h"
+#include "TuioStreamServer.h"
+
+namespace TUIO {
+
+	/**
+	 * The TuioStreamReceiver class connects to a {@link TuioStreamServer} through TCP or a Unix domain socket
+	 * and passes each received OSC packet to a PacketListener, such as the TuioClient.
+	 *
+	 * @version 1.4
+	 */
+	class TuioStreamReceiver {
+
+	private:
+		int socketFD;
+		IpEndpointName endpoint;
+		std::vector<char> buffer;
+
+		TuioStreamReceiver(int fd, const IpEndpointName &remote);
+		TuioStreamReceiver(const TuioStreamReceiver&);
+		TuioStreamReceiver& operator=(const TuioStreamReceiver&);
+
+	public:
+		/**
+		 * Connects to a TuioStreamServer listening to the provided TCP host and port.
+		 *
+		 * @param	host	the host name or address of the server
+		 * @param	port	the TCP port of the server
+		 * @return	the connected TuioStreamReceiver or NULL if the connection failed
+		 */
+		static TuioStreamReceiver* connectTcp(const char *host, int port);
+
+		/**
+		 * Connects to a TuioStreamServer listening to the Unix domain socket with the provided path.
+		 *
+		 * @param	path	the file system path of the socket
+		 * @return	the connected TuioStreamReceiver or NULL if the connection failed
+		 */
+		static TuioStreamReceiver* connectUnix(const char *path);
+
+		/**
+		 * The destructor closes the connection.
+		 */
+		~TuioStreamReceiver();
+
+		/**
+		 * Receives packets and passes them to the provided PacketListener until the connection
+		 * is closed by the server or Break() is called from another thread.
+		 *
+		 * @param	listener	the PacketListener to pass the packets to
+		 */
+		void Run(PacketListener *listener);
+
+		/**
+		 * Makes Run() return as soon as possible.
+		 */
+		void Break();
+	};
+};
+#endif /* INCLUDED_TUIOSTREAMRECEIVER_H */
@@ -0,0 +1,323 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioStreamServer.h"
+#include <iostream>
+#include <algorithm>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+using namespace TUIO;
+
+#define MAX_EPOLL_EVENTS 64
+
+#ifdef __linux__
+
+void* TuioStreamServer::threadFunc( void* obj )
+{
+	static_cast<TuioStreamServer*>(obj)->run();
+	return 0;
+};
+
+TuioStreamServer::TuioStreamServer(int queueSize)
+: maxQueue    (queueSize)
+, resyncCount (0)
+, running     (false)
+{
+	pthread_mutex_init(&clientMutex,NULL);
+	epollFD = epoll_create1(EPOLL_CLOEXEC);
+	wakeFD = eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC);
+
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.fd = wakeFD;
+	epoll_ctl(epollFD, EPOLL_CTL_ADD, wakeFD, &ev);
+}
+
+TuioStreamServer::~TuioStreamServer() {
+	if (running) {
+		running = false;
+		eventfd_write(wakeFD,1);
+		pthread_join(thread,NULL);
+	}
+
+	for (std::map<int,Client>::iterator iter=clients.begin(); iter!=clients.end(); iter++)
+		close(iter->first);
+	for (unsigned int i=0;i<listeners.size();i++)
+		close(listeners[i]);
+	close(wakeFD);
+	close(epollFD);
+	pthread_mutex_destroy(&clientMutex);
+}
+
+bool TuioStreamServer::addListener(int fd) {
+	if ((listen(fd,SOMAXCONN)<0) || (fcntl(fd,F_SETFL,fcntl(fd,F_GETFL)|O_NONBLOCK)<0)) {
+		close(fd);
+		return false;
+	}
+
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	epoll_ctl(epollFD, EPOLL_CTL_ADD, fd, &ev);
+
+	pthread_mutex_lock(&clientMutex);
+	listeners.push_back(fd);
+	pthread_mutex_unlock(&clientMutex);
+
+	if (!running) {
+		running = true;
+		pthread_create(&thread, NULL, threadFunc, this);
+	}
+	return true;
+}
+
+bool TuioStreamServer::listenTcp(int port) {
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd<0) return false;
+
+	int on = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	struct sockaddr_in addr;
+	memset(&addr,0,sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+	if (bind(fd,(struct sockaddr*)&addr,sizeof(addr))<0) {
+		std::cerr << "could not bind to TCP port " << port << std::endl;
+		close(fd);
+		return false;
+	}
+	return addListener(fd);
+}
+
+bool TuioStreamServer::listenUnix(const char *path) {
+	struct sockaddr_un addr;
+	if (strlen(path)>=sizeof(addr.sun_path)) return false;
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd<0) return false;
+
+	memset(&addr,0,sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path,path);
+	unlink(path);
+	if (bind(fd,(struct sockaddr*)&addr,sizeof(addr))<0) {
+		std::cerr << "could not bind to Unix socket " << path << std::endl;
+		close(fd);
+		return false;
+	}
+	return addListener(fd);
+}
+
+bool TuioStreamServer::wantsFullFrame() {
+	pthread_mutex_lock(&clientMutex);
+	bool full = (resyncCount>0);
+	pthread_mutex_unlock(&clientMutex);
+	return full;
+}
+
+int TuioStreamServer::getClientCount() {
+	pthread_mutex_lock(&clientMutex);
+	int count = (int)clients.size();
+	pthread_mutex_unlock(&clientMutex);
+	return count;
+}
+
+// the client mutex needs to be locked
+void TuioStreamServer::closeClient(int fd) {
+	std::map<int,Client>::iterator iter = clients.find(fd);
+	if (iter==clients.end()) return;
+	if (iter->second.resync) resyncCount--;
+	clients.erase(iter);
+	close(fd);
+}
+
+void TuioStreamServer::acceptClients(int fd) {
+	for (;;) {
+		int client = accept4(fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (client<0) return;
+
+		int on = 1;
+		setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+		pthread_mutex_lock(&clientMutex);
+		Client &c = clients[client];
+		c.queueBytes = c.offset = 0;
+		c.resync = true;
+		resyncCount++;
+
+		struct epoll_event ev;
+		ev.events = EPOLLIN | EPOLLRDHUP;
+		ev.data.fd = client;
+		epoll_ctl(epollFD, EPOLL_CTL_ADD, client, &ev);
+		pthread_mutex_unlock(&clientMutex);
+	}
+}
+
+// the client mutex needs to be locked
+void TuioStreamServer::writeQueue(int fd, Client &client) {
+	while (!client.queue.empty()) {
+		std::vector<char> &chunk = client.queue.front();
+		int result = ::send(fd, &chunk[client.offset], chunk.size()-client.offset, MSG_NOSIGNAL);
+		if (result<0) {
+			if ((errno==EAGAIN) || (errno==EWOULDBLOCK) || (errno==EINTR)) break;
+			closeClient(fd);
+			return;
+		}
+
+		client.offset += result;
+		client.queueBytes -= result;
+		if (client.offset<(int)chunk.size()) break;
+		client.queue.pop_front();
+		client.offset = 0;
+	}
+
+	// only wait for the socket to become writable while anything is queued
+	struct epoll_event ev;
+	ev.events = EPOLLIN | EPOLLRDHUP | (client.queue.empty()?0:(uint32_t)EPOLLOUT);
+	ev.data.fd = fd;
+	epoll_ctl(epollFD, EPOLL_CTL_MOD, fd, &ev);
+}
+
+// the client mutex needs to be locked
+void TuioStreamServer::enqueue(Client &client, const char *data, int size) {
+	if (client.queueBytes+size>maxQueue) {
+		// coalesce to the next full frame instead of growing the queue,
+		// a partially written chunk needs to be completed to keep the stream framing intact
+		while (client.queue.size()>((client.offset>0)?1u:0u)) {
+			client.queueBytes -= (int)client.queue.back().size();
+			client.queue.pop_back();
+		}
+		if (!client.resync) resyncCount++;
+		client.resync = true;
+		return;
+	}
+
+	client.queue.push_back(std::vector<char>(data,data+size));
+	client.queueBytes += size;
+}
+
+void TuioStreamServer::send(const char * const *data, const int *sizes, int count, bool fullFrame) {
+	// frame all packets once for all clients
+	frame.clear();
+	for (int i=0;i<count;i++) {
+		unsigned int size = (unsigned int)sizes[i];
+		char prefix[4] = { (char)(size>>24), (char)(size>>16), (char)(size>>8), (char)size };
+		frame.insert(frame.end(),prefix,prefix+4);
+		frame.insert(frame.end(),data[i],data[i]+sizes[i]);
+	}
+	if (frame.empty()) return;
+
+	pthread_mutex_lock(&clientMutex);
+	std::map<int,Client>::iterator iter = clients.begin();
+	while (iter!=clients.end()) {
+		int fd = iter->first;
+		Client &client = iter->second;
+		iter++;
+
+		if (client.resync) {
+			if (!fullFrame) continue;
+			client.resync = false;
+			resyncCount--;
+		}
+
+		// the queue is written by the background thread once the socket becomes writable
+		if (!client.queue.empty()) {
+			enqueue(client,&frame[0],(int)frame.size());
+			continue;
+		}
+
+		// write directly as long as the socket accepts the data, and queue the rest
+		int result = ::send(fd, &frame[0], frame.size(), MSG_NOSIGNAL);
+		if (result<0) {
+			if ((errno!=EAGAIN) && (errno!=EWOULDBLOCK) && (errno!=EINTR)) {
+				closeClient(fd);
+				continue;
+			}
+			result = 0;
+		}
+		if (result<(int)frame.size()) {
+			client.queue.push_back(std::vector<char>(frame.begin()+result,frame.end()));
+			client.queueBytes = (int)frame.size()-result;
+			writeQueue(fd,client);
+		}
+	}
+	pthread_mutex_unlock(&clientMutex);
+}
+
+void TuioStreamServer::run() {
+	struct epoll_event events[MAX_EPOLL_EVENTS];
+	char discard[256];
+
+	// the thread is only woken up through the eventfd when the server is deleted
+	for (;;) {
+		int count = epoll_wait(epollFD, events, MAX_EPOLL_EVENTS, -1);
+		for (int i=0;i<count;i++) {
+			int fd = events[i].data.fd;
+			if (fd==wakeFD) return;
+
+			pthread_mutex_lock(&clientMutex);
+			bool listener = (std::find(listeners.begin(),listeners.end(),fd)!=listeners.end());
+			pthread_mutex_unlock(&clientMutex);
+			if (listener) {
+				acceptClients(fd);
+				continue;
+			}
+
+			pthread_mutex_lock(&clientMutex);
+			std::map<int,Client>::iterator iter = clients.find(fd);
+			if (iter!=clients.end()) {
+				if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) closeClient(fd);
+				else {
+					// clients are not supposed to send anything
+					if ((events[i].events & EPOLLIN) && (recv(fd,discard,sizeof(discard),0)==0)) closeClient(fd);
+					else if (events[i].events & EPOLLOUT) writeQueue(fd,iter->second);
+				}
+			}
+			pthread_mutex_unlock(&clientMutex);
+		}
+	}
+}
+
+#else
+
+TuioStreamServer::TuioStreamServer(int queueSize):maxQueue(queueSize),resyncCount(0),epollFD(-1),wakeFD(-1),running(false) {}
+TuioStreamServer::~TuioStreamServer() {}
+bool TuioStreamServer::listenTcp(int port) { return false; }
+bool TuioStreamServer::listenUnix(const char *path) { return false; }
+bool TuioStreamServer::wantsFullFrame() { return false; }
+int TuioStreamServer::getClientCount() { return 0; }
+void TuioStreamServer::send(const char * const *data, const int *sizes, int count, bool fullFrame) {}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOSTREAMSERVER_H
+#define INCLUDED_TUIOSTREAMSERVER_H
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+#include <vector>
+#include <deque>
+#include <map>
+
+#define TUIO_STREAM_MAX_QUEUE 262144	// queued bytes per client before its queue is coalesced
+#define TUIO_STREAM_MAX_PACKET 1048576	// largest packet accepted by a TuioStreamReceiver
+
+namespace TUIO {
+
+	/**
+	 * The TuioStreamServer class sends the OSC packets of each TUIO frame to any number of clients connected
+	 * through TCP or Unix domain sockets, using the OSC 1.0 stream framing with a big-endian int32 size
+	 * in front of each packet. Each frame is framed once and written to all clients with non-blocking writes.
+	 * Whatever a client does not accept right away is queued and written by a background thread,
+	 * which also accepts new clients and handles all connections through a single epoll instance.
+	 * If the queue of a stalled client exceeds its limit, all queued frames are dropped and the client
+	 * skips all following frames until the next full frame, which holds the complete state again.
+	 * Newly connected clients start with a full frame as well. The stream transport requires Linux.
+	 *
+	 * @version 1.4
+	 */
+	class TuioStreamServer {
+
+	private:
+		struct Client {
+			std::deque< std::vector<char> > queue;
+			int queueBytes;
+			int offset;	// bytes of the front chunk which have been written already
+			bool resync;	// waits for the next full frame
+		};
+
+		std::map<int,Client> clients;
+		std::vector<int> listeners;
+		std::vector<char> frame;
+		int maxQueue;
+		int resyncCount;
+		int epollFD;
+		int wakeFD;
+		bool running;
+
+#ifndef WIN32
+		pthread_t thread;
+		pthread_mutex_t clientMutex;
+#endif
+
+		bool addListener(int fd);
+		void acceptClients(int fd);
+		void closeClient(int fd);
+		void writeQueue(int fd, Client &client);
+		void enqueue(Client &client, const char *data, int size);
+		void run();
+
+#ifndef WIN32
+		static void* threadFunc(void *obj);
+#endif
+
+		TuioStreamServer(const TuioStreamServer&);
+		TuioStreamServer& operator=(const TuioStreamServer&);
+
+	public:
+		/**
+		 * This constructor creates a TuioStreamServer without any listening sockets.
+		 *
+		 * @param	queueSize	the number of bytes which may be queued for a single client
+		 */
+		TuioStreamServer(int queueSize = TUIO_STREAM_MAX_QUEUE);
+
+		/**
+		 * The destructor stops the background thread and closes all connections.
+		 */
+		~TuioStreamServer();
+
+		/**
+		 * Accepts clients on the provided TCP port.
+		 *
+		 * @param	port	the TCP port to listen to
+		 * @return	false if the port could not be bound
+		 */
+		bool listenTcp(int port);
+
+		/**
+		 * Accepts clients on the Unix domain socket with the provided path, replacing any stale socket file.
+		 *
+		 * @param	path	the file system path of the socket
+		 * @return	false if the socket could not be bound
+		 */
+		bool listenUnix(const char *path);
+
+		/**
+		 * Returns true if any client waits for a full frame.
+		 * @return	true if the next frame should hold the complete state
+		 */
+		bool wantsFullFrame();
+
+		/**
+		 * Returns the number of connected clients.
+		 * @return	the number of connected clients
+		 */
+		int getClientCount();
+
+		/**
+		 * Sends the provided packets to all connected clients.
+		 *
+		 * @param	data	the packet data
+		 * @param	sizes	the packet sizes
+		 * @param	count	the number of packets
+		 * @param	fullFrame	true if the packets start a frame holding the complete state
+		 */
+		void send(const char * const *data, const int *sizes, int count, bool fullFrame);
+	};
+};
+#endif /* INCLUDED_TUIOSTREAMSERVER_H */
@@ -19,16 +19,17 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+
 #include "TuioTime.h"
 using namespace TUIO;
+
+// seconds between the NTP epoch (1900) and the Unix epoch (1970)
+#define NTP_UNIX_OFFSET 2208988800ULL
 	
-long TuioTime::start_seconds = 0;
-long TuioTime::start_micro_seconds = 0;
+long long TuioTime::start_nano_seconds = 0;
 
 void TuioTime::initSession() {
-	TuioTime startTime = TuioTime::getSystemTime();
-	start_seconds = startTime.getSeconds();
-	start_micro_seconds = startTime.getMicroseconds();
+	start_nano_seconds = TuioTime::getSystemTime().getTotalNanoseconds();
 }
 
 TuioTime TuioTime::getSessionTime() {
@@ -36,17 +37,51 @@ TuioTime TuioTime::getSessionTime() {
 }
 
 TuioTime TuioTime::getStartTime() {
-	return TuioTime(start_seconds,start_micro_seconds);
+	return fromNanoseconds(start_nano_seconds);
 }
 
 TuioTime TuioTime::getSystemTime() {
 #ifdef WIN32
-	TuioTime systemTime(GetTickCount());
+	static LARGE_INTEGER frequency;
+	if (frequency.QuadPart==0) QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	long long sec = counter.QuadPart/frequency.QuadPart;
+	long long rest = counter.QuadPart%frequency.QuadPart;
+	return fromNanoseconds(sec*NSEC_SECOND + rest*NSEC_SECOND/frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return fromNanoseconds((long long)ts.tv_sec*NSEC_SECOND + ts.tv_nsec);
+#else
+	return getWallTime();
+#endif	
+}
+
+TuioTime TuioTime::getWallTime() {
+#ifdef WIN32
+	// FILETIME counts 100ns intervals since 1601
+	FILETIME ft;
+	GetSystemTimeAsFileTime(&ft);
+	long long intervals = ((long long)ft.dwHighDateTime<<32) | ft.dwLowDateTime;
+	return fromNanoseconds((intervals - 116444736000000000LL)*100);
 #else
 	struct timeval tv;
-	struct timezone tz;
-	gettimeofday(&tv,&tz);
-	TuioTime systemTime(tv.tv_sec,tv.tv_usec);
+	gettimeofday(&tv,NULL);
+	return TuioTime(tv.tv_sec,tv.tv_usec);
 #endif	
-	return systemTime;
+}
+
+unsigned long long TuioTime::getTimeTag() const {
+	long long wall = getWallTime().getTotalNanoseconds() - (getSessionTime().getTotalNanoseconds() - nano_seconds);
+	unsigned long long sec = (unsigned long long)floorDiv(wall,NSEC_SECOND);
+	unsigned long long nsec = (unsigned long long)(wall - (long long)sec*NSEC_SECOND);
+	return ((sec + NTP_UNIX_OFFSET)<<32) | ((nsec<<32)/NSEC_SECOND);
+}
+
+TuioTime TuioTime::fromTimeTag(unsigned long long timetag) {
+	long long sec = (long long)(timetag>>32) - (long long)NTP_UNIX_OFFSET;
+	long long nsec = (long long)(((timetag & 0xffffffffULL)*NSEC_SECOND)>>32);
+	long long wall = sec*NSEC_SECOND + nsec;
+	return fromNanoseconds(getSessionTime().getTotalNanoseconds() - (getWallTime().getTotalNanoseconds() - wall));
 }
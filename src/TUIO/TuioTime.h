@@ -19,12 +19,14 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+
 #ifndef INCLUDED_TUIOTIME_H
 #define INCLUDED_TUIOTIME_H
 
 #ifndef WIN32
 #include <pthread.h>
 #include <sys/time.h>
+#include <time.h>
 #else
 #include <windows.h>
 #endif
@@ -32,14 +34,19 @@
 #define MSEC_SECOND 1000
 #define USEC_SECOND 1000000
 #define USEC_MILLISECOND 1000
+#define NSEC_MICROSECOND 1000LL
+#define NSEC_MILLISECOND 1000000LL
+#define NSEC_SECOND 1000000000LL
 
 namespace TUIO {
 	
 	/**
 	 * The TuioTime class is a simple structure that is used to reprent the time that has elapsed since the session start.
-	 * The time is internally represented as seconds and fractions of microseconds which should be more than sufficient for gesture related timing requirements.
+	 * The time is internally represented as a 64bit count of Nanoseconds taken from a monotonic system clock,
+	 * which is not affected by wall clock adjustments and therefore never runs backwards.
 	 * Therefore at the beginning of a typical TUIO session the static method initSession() will set the reference time for the session. 
 	 * Another important static method getSessionTime will return a TuioTime object representing the time elapsed since the session start.
+	 * The wall clock is only used when converting from or to OSC time tags.
 	 * The class also provides various addtional convience method, which allow some simple time arithmetics.
 	 *
 	 * @author Martin Kaltenbrunner
@@ -48,18 +55,23 @@ namespace TUIO {
 	class TuioTime {
 		
 	private:
-		long seconds, micro_seconds;
-		static long start_seconds, start_micro_seconds;
+		long long nano_seconds;
+		static long long start_nano_seconds;
+		
+		static long long floorDiv(long long value, long long divisor) {
+			long long result = value/divisor;
+			if ((value%divisor)<0) result--;
+			return result;
+		}
 		
 	public:
 
 		/**
 		 * The default constructor takes no arguments and sets   
-		 * the Seconds and Microseconds attributes of the newly created TuioTime both to zero.
+		 * the time of the newly created TuioTime to zero.
 		 */
 		TuioTime () {
-			seconds = 0;
-			micro_seconds = 0;
+			nano_seconds = 0;
 		};
 
 		/**
@@ -74,8 +86,7 @@ namespace TUIO {
 		 * @param  msec  the total time in Millseconds
 		 */
 		TuioTime (long msec) {
-			seconds = msec/MSEC_SECOND;
-			micro_seconds = USEC_MILLISECOND*(msec%MSEC_SECOND);
+			nano_seconds = (long long)msec*NSEC_MILLISECOND;
 		};
 		
 		/**
@@ -86,8 +97,19 @@ namespace TUIO {
 		 * @param  usec	the microseconds time component
 		 */	
 		TuioTime (long sec, long usec) {
-			seconds = sec;
-			micro_seconds = usec;
+			nano_seconds = (long long)sec*NSEC_SECOND + (long long)usec*NSEC_MICROSECOND;
+		};
+
+		/**
+		 * Returns a TuioTime representing the provided time in total Nanoseconds.
+		 *
+		 * @param  nsec	the total time in Nanoseconds
+		 * @return a TuioTime representing the provided time
+		 */	
+		static TuioTime fromNanoseconds(long long nsec) {
+			TuioTime ttime;
+			ttime.nano_seconds = nsec;
+			return ttime;
 		};
 
 		/**
@@ -96,127 +118,172 @@ namespace TUIO {
 		 * @param  us	the total time to add in Microseconds
 		 * @return the sum of this TuioTime with the provided argument in microseconds
 		 */	
-		TuioTime operator+(long us) {
-			long sec = seconds + us/USEC_SECOND;
-			long usec = micro_seconds + us%USEC_SECOND;
-			return TuioTime(sec,usec);
+		TuioTime operator+(long us) const {
+			return fromNanoseconds(nano_seconds + (long long)us*NSEC_MICROSECOND);
 		};
 		
 		/**
-		 * Sums the provided TuioTime to the private Seconds and Microseconds attributes.  
+		 * Sums the provided TuioTime to this TuioTime.  
 		 *
 		 * @param  ttime	the TuioTime to add
 		 * @return the sum of this TuioTime with the provided TuioTime argument
 		 */
-		TuioTime operator+(TuioTime ttime) {
-			long sec = seconds + ttime.getSeconds();
-			long usec = micro_seconds + ttime.getMicroseconds();
-			sec += usec/USEC_SECOND;
-			usec = usec%USEC_SECOND;
-			return TuioTime(sec,usec);
+		TuioTime operator+(const TuioTime &ttime) const {
+			return fromNanoseconds(nano_seconds + ttime.nano_seconds);
 		};
 
 		/**
-		 * Subtracts the provided time represented in Microseconds from the private Seconds and Microseconds attributes.
+		 * Subtracts the provided time represented in Microseconds from this TuioTime.
 		 *
 		 * @param  us	the total time to subtract in Microseconds
 		 * @return the subtraction result of this TuioTime minus the provided time in Microseconds
 		 */		
-		TuioTime operator-(long us) {
-			long sec = seconds - us/USEC_SECOND;
-			long usec = micro_seconds - us%USEC_SECOND;
-			
-			if (usec<0) {
-				usec += USEC_SECOND;
-				sec--;
-			}			
-			
-			return TuioTime(sec,usec);
+		TuioTime operator-(long us) const {
+			return fromNanoseconds(nano_seconds - (long long)us*NSEC_MICROSECOND);
 		};
 
 		/**
-		 * Subtracts the provided TuioTime from the private Seconds and Microseconds attributes.
+		 * Subtracts the provided TuioTime from this TuioTime.
 		 *
 		 * @param  ttime	the TuioTime to subtract
 		 * @return the subtraction result of this TuioTime minus the provided TuioTime
 		 */	
-		TuioTime operator-(TuioTime ttime) {
-			long sec = seconds - ttime.getSeconds();
-			long usec = micro_seconds - ttime.getMicroseconds();
-			
-			if (usec<0) {
-				usec += USEC_SECOND;
-				sec--;
-			}
-			
-			return TuioTime(sec,usec);
+		TuioTime operator-(const TuioTime &ttime) const {
+			return fromNanoseconds(nano_seconds - ttime.nano_seconds);
+		};
+		
+		/**
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
+		 *
+		 * @param  ttime	the TuioTime to compare
+		 * @return true if the two TuioTime are equal
+		 */	
+		bool operator==(const TuioTime &ttime) const {
+			return (nano_seconds==ttime.nano_seconds);
 		};
 
+		/**
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
+		 *
+		 * @param  ttime	the TuioTime to compare
+		 * @return true if the two TuioTime are different
+		 */	
+		bool operator!=(const TuioTime &ttime) const {
+			return (nano_seconds!=ttime.nano_seconds);
+		};
 		
 		/**
-		 * Assigns the provided TuioTime to the private Seconds and Microseconds attributes.
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
 		 *
-		 * @param  ttime	the TuioTime to assign
+		 * @param  ttime	the TuioTime to compare
+		 * @return true if this TuioTime is earlier than the provided TuioTime
 		 */	
-		void operator=(TuioTime ttime) {
-			seconds = ttime.getSeconds();
-			micro_seconds = ttime.getMicroseconds();
+		bool operator<(const TuioTime &ttime) const {
+			return (nano_seconds<ttime.nano_seconds);
 		};
 		
 		/**
-		 * Takes a TuioTime argument and compares the provided TuioTime to the private Seconds and Microseconds attributes.
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
 		 *
 		 * @param  ttime	the TuioTime to compare
-		 * @return true if the two TuioTime have equal Seconds and Microseconds attributes
+		 * @return true if this TuioTime is later than the provided TuioTime
 		 */	
-		bool operator==(TuioTime ttime) {
-			if ((seconds==(long)ttime.getSeconds()) && (micro_seconds==(long)ttime.getMicroseconds())) return true;
-			else return false;
+		bool operator>(const TuioTime &ttime) const {
+			return (nano_seconds>ttime.nano_seconds);
 		};
-
+		
+		/**
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
+		 *
+		 * @param  ttime	the TuioTime to compare
+		 * @return true if this TuioTime is earlier than or equal to the provided TuioTime
+		 */	
+		bool operator<=(const TuioTime &ttime) const {
+			return (nano_seconds<=ttime.nano_seconds);
+		};
+		
 		/**
-		 * Takes a TuioTime argument and compares the provided TuioTime to the private Seconds and Microseconds attributes.
+		 * Takes a TuioTime argument and compares the provided TuioTime to this TuioTime.
 		 *
 		 * @param  ttime	the TuioTime to compare
-		 * @return true if the two TuioTime have differnt Seconds or Microseconds attributes
+		 * @return true if this TuioTime is later than or equal to the provided TuioTime
 		 */	
-		bool operator!=(TuioTime ttime) {
-			if ((seconds!=(long)ttime.getSeconds()) || (micro_seconds!=(long)ttime.getMicroseconds())) return true;
-			else return false;
+		bool operator>=(const TuioTime &ttime) const {
+			return (nano_seconds>=ttime.nano_seconds);
 		};
 		
 		/**
-		 * Resets the seconds and micro_seconds attributes to zero.
+		 * Resets the time of this TuioTime to zero.
 		 */
 		void reset() {
-			seconds = 0;
-			micro_seconds = 0;
+			nano_seconds = 0;
 		};
 		
 		/**
 		 * Returns the TuioTime Seconds component.
 		 * @return the TuioTime Seconds component
 		 */	
-		long getSeconds() {
-			return seconds;
+		long getSeconds() const {
+			return (long)floorDiv(nano_seconds,NSEC_SECOND);
 		};
 		
 		/**
 		 * Returns the TuioTime Microseconds component.
 		 * @return the TuioTime Microseconds component
 		 */	
-		long getMicroseconds() {
-			return micro_seconds;
+		long getMicroseconds() const {
+			return (long)((nano_seconds - floorDiv(nano_seconds,NSEC_SECOND)*NSEC_SECOND)/NSEC_MICROSECOND);
 		};
 		
 		/**
 		 * Returns the total TuioTime in Milliseconds.
 		 * @return the total TuioTime in Milliseconds
 		 */	
-		long getTotalMilliseconds() {
-			return seconds*MSEC_SECOND+micro_seconds/MSEC_SECOND;
+		long getTotalMilliseconds() const {
+			return (long)floorDiv(nano_seconds,NSEC_MILLISECOND);
 		};
 		
+		/**
+		 * Returns the total TuioTime in Microseconds.
+		 * @return the total TuioTime in Microseconds
+		 */	
+		long long getTotalMicroseconds() const {
+			return floorDiv(nano_seconds,NSEC_MICROSECOND);
+		};
+		
+		/**
+		 * Returns the total TuioTime in Nanoseconds.
+		 * @return the total TuioTime in Nanoseconds
+		 */	
+		long long getTotalNanoseconds() const {
+			return nano_seconds;
+		};
+		
+		/**
+		 * Returns the total TuioTime in fractional Seconds.
+		 * @return the total TuioTime in fractional Seconds
+		 */	
+		double getTotalSeconds() const {
+			return (double)nano_seconds/NSEC_SECOND;
+		};
+		
+		/**
+		 * Converts this TuioTime, representing the time since session start, 
+		 * into a 64bit OSC time tag (NTP format) based on the wall clock.
+		 *
+		 * @return the OSC time tag corresponding to this TuioTime
+		 */	
+		unsigned long long getTimeTag() const;
+		
+		/**
+		 * Converts the provided 64bit OSC time tag (NTP format) into
+		 * a TuioTime representing the time since session start.
+		 *
+		 * @param  timetag	the OSC time tag to convert
+		 * @return the TuioTime corresponding to the provided OSC time tag
+		 */	
+		static TuioTime fromTimeTag(unsigned long long timetag);
+		
 		/**
 		 * This static method globally resets the TUIO session time.
 		 */		
@@ -235,10 +302,16 @@ namespace TUIO {
 		static TuioTime getStartTime();
 		
 		/**
-		 * Returns the absolut TuioTime representing the current system time.
-		 * @return the absolut TuioTime representing the current system time
+		 * Returns the absolut TuioTime representing the current monotonic system time.
+		 * @return the absolut TuioTime representing the current monotonic system time
 		 */	
 		static TuioTime getSystemTime();
+		
+		/**
+		 * Returns the absolut TuioTime representing the current wall clock time since the Unix epoch.
+		 * @return the absolut TuioTime representing the current wall clock time
+		 */	
+		static TuioTime getWallTime();
 	};
 };
 #endif /* INCLUDED_TUIOTIME_H */
@@ -0,0 +1,113 @@
+/*
+ TUIO C++ Library - part of the reacTIVision project
+ http://reactivision.sourceforge.net/
+
+ Copyright (c) 2005-2009 Martin Kaltenbrunner <mkalten@iua.upf.edu>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_TUIOTRIPLEBUFFER_H
+#define INCLUDED_TUIOTRIPLEBUFFER_H
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+namespace TUIO {
+
+	/**
+	 * The TuioTripleBuffer class passes the most recent copy of a value from a single writer thread
+	 * to a single reader thread without any locks. The writer fills the back buffer and publishes it,
+	 * the reader picks up the most recently published buffer, and neither of them ever waits for the other.
+	 * Published buffers which have not been picked up by the reader are overwritten by later ones.
+	 * <p><code>
+	 * buffer.getBack() = value;<br/>
+	 * buffer.publish();<br/>
+	 * ...<br/>
+	 * const T &amp;latest = buffer.getFront();<br/>
+	 * </code></p>
+	 *
+	 * @version 1.4
+	 */
+	template<class T> class TuioTripleBuffer {
+
+	private:
+		enum { INDEX_MASK = 3, FRESH = 4 };
+
+		T buffers[3];
+		int back;
+		int front;
+		volatile long middle;
+
+		// atomically reads the middle index
+		long load() {
+#ifdef WIN32
+			return InterlockedCompareExchange(&middle, 0, 0);
+#else
+			return __sync_fetch_and_or(&middle, 0);
+#endif
+		}
+
+		// atomically replaces the middle index, acting as a full memory barrier
+		long exchange(long value) {
+#ifdef WIN32
+			return InterlockedExchange(&middle, value);
+#else
+			long previous;
+			do {
+				previous = load();
+			} while (__sync_val_compare_and_swap(&middle, previous, value) != previous);
+			return previous;
+#endif
+		}
+
+		TuioTripleBuffer(const TuioTripleBuffer&);
+		TuioTripleBuffer& operator=(const TuioTripleBuffer&);
+
+	public:
+		/**
+		 * The default constructor creates a TuioTripleBuffer holding three default constructed values.
+		 */
+		TuioTripleBuffer():back(0),front(1),middle(2) {};
+
+		/**
+		 * Returns the back buffer, which may only be accessed by the writer thread.
+		 * Its content is left over from an earlier value and needs to be overwritten completely.
+		 * @return	the back buffer
+		 */
+		T& getBack() {
+			return buffers[back];
+		};
+
+		/**
+		 * Publishes the back buffer to the reader thread and provides a new back buffer.
+		 */
+		void publish() {
+			back = (int)(exchange(back | FRESH) & INDEX_MASK);
+		};
+
+		/**
+		 * Returns the most recently published buffer, which may only be accessed by the reader thread
+		 * until the next call to getFront().
+		 * @return	the most recently published buffer
+		 */
+		const T& getFront() {
+			if (load() & FRESH) front = (int)(exchange(front) & INDEX_MASK);
+			return buffers[front];
+		};
+	};
+};
+#endif /* INCLUDED_TUIOTRIPLEBUFFER_H */
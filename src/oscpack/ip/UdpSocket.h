@@ -101,6 +101,12 @@ public:
 	void Send( const char *data, int size );
     void SendTo( const IpEndpointName& remoteEndpoint, const char *data, int size );
 
+	// Send several datagrams to the connected remote endpoint, using a
+	// single system call where the platform supports it (sendmmsg).
+	// Both return the number of datagrams accepted by the socket
+	int SendBatch( const char * const *data, const int *sizes, int count );
+	int SendBatchTo( const IpEndpointName& remoteEndpoint, const char * const *data, const int *sizes, int count );
+
 
 	// Bind a local endpoint to receive incoming data. Endpoint
 	// can be 'any' for the system to choose an endpoint
@@ -148,6 +154,14 @@ public:
         { mux_.DetachSocketListener( this, listener_ ); }
 
     // see SocketReceiveMultiplexer above for the behaviour of these methods...
+    void AttachSocketListener( UdpSocket *socket, PacketListener *listener )
+        { mux_.AttachSocketListener( socket, listener ); }
+
+    void AttachPeriodicTimerListener( int periodMilliseconds, TimerListener *listener )
+        { mux_.AttachPeriodicTimerListener( periodMilliseconds, listener ); }
+    void DetachPeriodicTimerListener( TimerListener *listener )
+        { mux_.DetachPeriodicTimerListener( listener ); }
+
     void Run() { mux_.Run(); }
 	void RunUntilSigInt() { mux_.RunUntilSigInt(); }
     void Break() { mux_.Break(); }
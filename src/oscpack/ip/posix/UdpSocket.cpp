@@ -52,6 +52,15 @@
 #include "ip/TimerListener.h"
 
 
+#if defined(__linux__) && defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 14)))
+#define OSC_HAVE_SENDMMSG
+#include <sys/uio.h>
+#endif
+
+// maximum number of datagrams submitted with a single sendmmsg() call
+#define MAX_SEND_BATCH 64
+
+
 #if defined(__APPLE__) && !defined(_SOCKLEN_T)
 // pre system 10.3 didn have socklen_t
 typedef ssize_t socklen_t;
@@ -181,6 +190,60 @@ public:
         send( socket_, data, size, 0 );
 	}
 
+	int SendBatch( const char * const *data, const int *sizes, int count )
+	{
+		assert( isConnected_ );
+
+		return SendBatchToAddr( NULL, data, sizes, count );
+	}
+
+	int SendBatchTo( const IpEndpointName& remoteEndpoint, const char * const *data, const int *sizes, int count )
+	{
+		sendToAddr_.sin_addr.s_addr = htonl( remoteEndpoint.address );
+        sendToAddr_.sin_port = htons( remoteEndpoint.port );
+
+		return SendBatchToAddr( &sendToAddr_, data, sizes, count );
+	}
+
+	// sends to the connected endpoint if addr is NULL, returns the
+	// number of datagrams which have been accepted by the socket
+	int SendBatchToAddr( struct sockaddr_in *addr, const char * const *data, const int *sizes, int count )
+	{
+		int sent = 0;
+#ifdef OSC_HAVE_SENDMMSG
+		struct mmsghdr messages[MAX_SEND_BATCH];
+		struct iovec vectors[MAX_SEND_BATCH];
+
+		while( sent < count ){
+			int batch = std::min( count - sent, MAX_SEND_BATCH );
+			memset( messages, 0, sizeof(struct mmsghdr) * batch );
+			for( int i=0; i < batch; ++i ){
+				vectors[i].iov_base = const_cast<char*>( data[sent + i] );
+				vectors[i].iov_len = sizes[sent + i];
+				messages[i].msg_hdr.msg_name = addr;
+				messages[i].msg_hdr.msg_namelen = addr ? sizeof(*addr) : 0;
+				messages[i].msg_hdr.msg_iov = &vectors[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			// fall back to individual sends below if sendmmsg is
+			// not available at runtime or did not accept any datagram
+			int result = sendmmsg( socket_, messages, batch, 0 );
+			if( result <= 0 )
+				break;
+			sent += result;
+		}
+#endif
+		int accepted = sent;
+		for( ; sent < count; ++sent ){
+			int result = addr ? sendto( socket_, data[sent], sizes[sent], 0, (sockaddr*)addr, sizeof(*addr) )
+					: send( socket_, data[sent], sizes[sent], 0 );
+			if( result >= 0 )
+				++accepted;
+		}
+		return accepted;
+	}
+
     void SendTo( const IpEndpointName& remoteEndpoint, const char *data, int size )
 	{
 		sendToAddr_.sin_addr.s_addr = htonl( remoteEndpoint.address );
@@ -254,6 +317,16 @@ void UdpSocket::SendTo( const IpEndpointName& remoteEndpoint, const char *data,
 	impl_->SendTo( remoteEndpoint, data, size );
 }
 
+int UdpSocket::SendBatch( const char * const *data, const int *sizes, int count )
+{
+	return impl_->SendBatch( data, sizes, count );
+}
+
+int UdpSocket::SendBatchTo( const IpEndpointName& remoteEndpoint, const char * const *data, const int *sizes, int count )
+{
+	return impl_->SendBatchTo( remoteEndpoint, data, sizes, count );
+}
+
 void UdpSocket::Bind( const IpEndpointName& localEndpoint )
 {
 	impl_->Bind( localEndpoint );
@@ -433,6 +506,10 @@ public:
 				char c;
 				ssize_t ret; 
 				ret = read( breakPipe_[0], &c, 1 );
+
+				// AsynchronousBreak() may have been called before Run() reset break_
+				if( ret == 1 )
+					break_ = true;
 			}
 			
 			if( break_ )
@@ -30,10 +30,10 @@
 #ifndef INCLUDED_MESSAGEMAPPINGOSCPACKETLISTENER_H
 #define INCLUDED_MESSAGEMAPPINGOSCPACKETLISTENER_H
 
-#include <string.h>
-#include <map>
+#include <vector>
 
 #include "OscPacketListener.h"
+#include "OscAddressTrie.h"
 
 
 
@@ -45,27 +45,38 @@ public:
     typedef void (T::*function_type)(const osc::ReceivedMessage&, const IpEndpointName&);
 
 protected:
+    // the functions need to be registered before any message is received,
+    // only the first function registered for an address is kept
     void RegisterMessageFunction( const char *addressPattern, function_type f )
     {
-        functions_.insert( std::make_pair( addressPattern, f ) );
+        if( addresses_.Find( addressPattern ) != -1 )
+            return;
+
+        addresses_.Insert( addressPattern, (int)functions_.size() );
+        functions_.push_back( f );
+        matches_.push_back( 0 );
     }
 
+    // received address patterns containing wildcards invoke the functions of
+    // all matching addresses
     virtual void ProcessMessage( const osc::ReceivedMessage& m,
 		const IpEndpointName& remoteEndpoint )
     {
-        typename function_map_type::iterator i = functions_.find( m.AddressPattern() );
-        if( i != functions_.end() )
-            (dynamic_cast<T*>(this)->*(i->second))( m, remoteEndpoint );
+        // T derives from this class, so no runtime check is needed for the cast
+        int index = addresses_.Find( m.AddressPattern() );
+        if( index != -1 ){
+            (static_cast<T*>(this)->*(functions_[index]))( m, remoteEndpoint );
+        }else if( !functions_.empty() && HasAddressWildcards( m.AddressPattern() ) ){
+            int count = addresses_.Match( m.AddressPattern(), &matches_[0], (int)matches_.size() );
+            for( int i=0; i < count; ++i )
+                (static_cast<T*>(this)->*(functions_[ matches_[i] ]))( m, remoteEndpoint );
+        }
     }
     
 private:
-    struct cstr_compare{
-        bool operator()( const char *lhs, const char *rhs ) const
-            { return strcmp( lhs, rhs ) < 0; }
-    };
-
-    typedef std::map<const char*, function_type, cstr_compare> function_map_type;
-    function_map_type functions_;
+    AddressTrie addresses_;
+    std::vector<function_type> functions_;
+    std::vector<int> matches_;
 };
 
 } // namespace osc
@@ -0,0 +1,294 @@
+/*
+	oscpack -- Open Sound Control packet manipulation library
+	http://www.audiomulch.com/~rossb/oscpack
+
+	Copyright (c) 2004-2005 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "OscAddressTrie.h"
+
+#include <string.h>
+#include <algorithm>
+
+
+namespace osc{
+
+
+AddressTrie::AddressTrie()
+{
+}
+
+
+void AddressTrie::Insert( const char *address, int value )
+{
+    std::vector< std::pair<std::string, int> >::iterator i =
+            std::lower_bound( addresses_.begin(), addresses_.end(),
+                    std::make_pair( std::string( address ), -1 ) );
+
+    if( i != addresses_.end() && i->first == address ){
+        i->second = value;
+        return;
+    }
+    addresses_.insert( i, std::make_pair( std::string( address ), value ) );
+
+    nodes_.resize( 1 );
+    branchChars_.resize( 1 );
+    Build( 0, 0, addresses_.size(), 0 );
+}
+
+
+// builds the subtree for the sorted addresses first..last-1,
+// which share at least their first depth characters
+void AddressTrie::Build( int node, std::size_t first, std::size_t last, std::size_t depth )
+{
+    nodes_[node].position = 0;
+    nodes_[node].firstChild = 0;
+    nodes_[node].childCount = 0;
+    nodes_[node].address = -1;
+
+    if( last - first == 1 ){
+        nodes_[node].address = (int)first;
+        return;
+    }
+
+    // the common prefix of a sorted range is the one of its first and last
+    // address, the terminating zero of the shorter one differs at its end
+    const char *lowest = addresses_[first].first.c_str();
+    const char *highest = addresses_[last-1].first.c_str();
+    std::size_t position = depth;
+    while( lowest[position] == highest[position] )
+        ++position;
+
+    nodes_[node].position = (int)position;
+    nodes_[node].firstChild = (int)nodes_.size();
+
+    std::size_t groupBegin = first;
+    for( std::size_t i=first+1; i <= last; ++i ){
+        if( i == last || addresses_[i].first.c_str()[position]
+                != addresses_[groupBegin].first.c_str()[position] ){
+            nodes_.push_back( Node() );
+            branchChars_.push_back( addresses_[groupBegin].first.c_str()[position] );
+            ++nodes_[node].childCount;
+            groupBegin = i;
+        }
+    }
+
+    // the children are built after all of them have been added next to each other
+    int child = nodes_[node].firstChild;
+    groupBegin = first;
+    for( std::size_t i=first+1; i <= last; ++i ){
+        if( i == last || addresses_[i].first.c_str()[position]
+                != addresses_[groupBegin].first.c_str()[position] ){
+            Build( child++, groupBegin, i, position + 1 );
+            groupBegin = i;
+        }
+    }
+}
+
+
+int AddressTrie::Find( const char *address ) const
+{
+    if( addresses_.empty() )
+        return -1;
+
+    std::size_t length = strlen( address );
+
+    const Node *node = &nodes_[0];
+    while( node->address == -1 ){
+        if( (std::size_t)node->position > length )
+            return -1;
+
+        char c = address[ node->position ];
+        int child = node->firstChild;
+        int lastChild = child + node->childCount;
+        while( child != lastChild && branchChars_[child] != c )
+            ++child;
+
+        if( child == lastChild )
+            return -1;
+        node = &nodes_[child];
+    }
+
+    const std::pair<std::string, int>& candidate = addresses_[ node->address ];
+    if( candidate.first.size() != length
+            || memcmp( candidate.first.data(), address, length ) != 0 )
+        return -1;
+
+    return candidate.second;
+}
+
+
+int AddressTrie::Match( const char *pattern, int *values, int maxValues ) const
+{
+    int count = 0;
+    for( std::size_t i=0; i < addresses_.size() && count < maxValues; ++i ){
+        if( AddressPatternMatches( pattern, addresses_[i].first.c_str() ) )
+            values[count++] = addresses_[i].second;
+    }
+    return count;
+}
+
+
+bool HasAddressWildcards( const char *address )
+{
+    return strpbrk( address, "?*[]{}" ) != 0;
+}
+
+
+namespace{
+
+// patterns are received from the network, so the positions from which the
+// rest of the pattern has failed to match the rest of the address are
+// remembered. otherwise patterns like "*a*a*a*a*b" would take exponential time.
+class AddressPatternMatcher{
+public:
+    AddressPatternMatcher( const char *pattern, const char *address )
+        : pattern_( pattern )
+        , address_( address )
+        , width_( strlen( address ) + 1 )
+        , failed_( (strlen( pattern ) + 1) * width_, false ) {}
+
+    bool Matches( const char *p, const char *a )
+    {
+        std::size_t state = (p - pattern_) * width_ + (a - address_);
+        if( failed_[state] )
+            return false;
+
+        bool result = MatchesFrom( p, a );
+        if( !result )
+            failed_[state] = true;
+        return result;
+    }
+
+private:
+    bool MatchesFrom( const char *p, const char *a );
+
+    const char *pattern_;
+    const char *address_;
+    std::size_t width_;
+    std::vector<bool> failed_;
+};
+
+
+bool AddressPatternMatcher::MatchesFrom( const char *p, const char *a )
+{
+    for(;;){
+        switch( *p ){
+            case '\0':
+                return *a == '\0';
+
+            case '?':
+                if( *a == '\0' || *a == '/' )
+                    return false;
+                ++p;
+                ++a;
+                break;
+
+            case '*':
+                // consecutive stars are equivalent to a single one
+                while( *p == '*' )
+                    ++p;
+                for(;;){
+                    if( Matches( p, a ) )
+                        return true;
+                    if( *a == '\0' || *a == '/' )
+                        return false;
+                    ++a;
+                }
+
+            case '[':
+                {
+                    if( *a == '\0' || *a == '/' )
+                        return false;
+
+                    ++p;
+                    bool negate = ( *p == '!' );
+                    if( negate )
+                        ++p;
+
+                    bool matched = false;
+                    while( *p != '\0' && *p != ']' ){
+                        char first = *p;
+                        char last = first;
+                        if( p[1] == '-' && p[2] != '\0' && p[2] != ']' ){
+                            last = p[2];
+                            p += 3;
+                        }else{
+                            ++p;
+                        }
+                        if( *a >= first && *a <= last )
+                            matched = true;
+                    }
+
+                    if( *p != ']' || matched == negate )
+                        return false;
+                    ++p;
+                    ++a;
+                }
+                break;
+
+            case '{':
+                {
+                    const char *end = strchr( p, '}' );
+                    if( end == 0 )
+                        return false;
+
+                    const char *alternative = p + 1;
+                    for(;;){
+                        const char *separator = alternative;
+                        while( separator != end && *separator != ',' )
+                            ++separator;
+
+                        std::size_t length = separator - alternative;
+                        if( strncmp( alternative, a, length ) == 0
+                                && Matches( end + 1, a + length ) )
+                            return true;
+
+                        if( separator == end )
+                            return false;
+                        alternative = separator + 1;
+                    }
+                }
+
+            default:
+                if( *p != *a )
+                    return false;
+                ++p;
+                ++a;
+                break;
+        }
+    }
+}
+
+} // namespace
+
+
+bool AddressPatternMatches( const char *pattern, const char *address )
+{
+    AddressPatternMatcher matcher( pattern, address );
+    return matcher.Matches( pattern, address );
+}
+
+} // namespace osc
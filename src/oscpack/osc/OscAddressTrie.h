@@ -0,0 +1,94 @@
+/*
+	oscpack -- Open Sound Control packet manipulation library
+	http://www.audiomulch.com/~rossb/oscpack
+
+	Copyright (c) 2004-2005 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INCLUDED_OSCADDRESSTRIE_H
+#define INCLUDED_OSCADDRESSTRIE_H
+
+#include <vector>
+#include <string>
+
+
+namespace osc{
+
+/*
+    AddressTrie maps the registered OSC addresses to integer values. The
+    trie is rebuilt whenever an address is registered, after which Find()
+    looks up a literal address with a single pass over its bytes. Addresses
+    must not contain any of the OSC pattern characters.
+
+    The trie only branches on the characters at which the registered
+    addresses differ, so common prefixes like "/tuio/" are skipped and the
+    address is compared with the single remaining candidate at once.
+
+    Received address patterns containing wildcards are matched against all
+    registered addresses by Match(), which is only needed if Find() fails.
+*/
+class AddressTrie{
+public:
+    AddressTrie();
+
+    // replaces the value of an already registered address
+    void Insert( const char *address, int value );
+
+    // returns the value of the address or -1 if it has not been registered
+    int Find( const char *address ) const;
+
+    // stores the values of all registered addresses matched by the pattern
+    // into values and returns their number, which is at most maxValues
+    int Match( const char *pattern, int *values, int maxValues ) const;
+
+    int Size() const { return (int)addresses_.size(); }
+
+private:
+    struct Node{
+        int position;     // the character branched on by inner nodes
+        int firstChild;
+        int childCount;
+        int address;      // the index of the address of leaves or -1
+    };
+
+    void Build( int node, std::size_t first, std::size_t last, std::size_t depth );
+
+    std::vector<Node> nodes_;
+    std::string branchChars_;  // the character each node has been reached by
+    std::vector< std::pair<std::string, int> > addresses_;  // sorted by address
+};
+
+
+// returns true if the address contains any of the OSC pattern characters
+bool HasAddressWildcards( const char *address );
+
+// matches an OSC address pattern against an address, supporting '?', '*',
+// character sets like [a-z] or [!0-9], and string lists like {cur,obj}.
+// wildcards do not match across the '/' separating the address parts.
+bool AddressPatternMatches( const char *pattern, const char *address );
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCADDRESSTRIE_H */
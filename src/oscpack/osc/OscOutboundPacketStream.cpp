@@ -42,20 +42,23 @@
 
 namespace osc{
 
-static void FromInt32( char *p, int32 x )
+static inline uint32 SwapBytes32( uint32 x )
 {
-#ifdef OSC_HOST_LITTLE_ENDIAN
-    union{
-        osc::int32 i;
-        char c[4];
-    } u;
+#if defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3))
+    return __builtin_bswap32( x );
+#elif defined(_MSC_VER)
+    return _byteswap_ulong( x );
+#else
+    return (x >> 24) | ((x >> 8) & 0xFF00) | ((x << 8) & 0xFF0000) | (x << 24);
+#endif
+}
 
-    u.i = x;
 
-    p[3] = u.c[0];
-    p[2] = u.c[1];
-    p[1] = u.c[2];
-    p[0] = u.c[3];
+static void FromInt32( char *p, int32 x )
+{
+#ifdef OSC_HOST_LITTLE_ENDIAN
+    uint32 u = SwapBytes32( (uint32)x );
+    memcpy( p, &u, 4 );
 #else
     *reinterpret_cast<int32*>(p) = x;
 #endif
@@ -65,19 +68,27 @@ static void FromInt32( char *p, int32 x )
 static void FromUInt32( char *p, uint32 x )
 {
 #ifdef OSC_HOST_LITTLE_ENDIAN
-    union{
-        osc::uint32 i;
-        char c[4];
-    } u;
+    uint32 u = SwapBytes32( x );
+    memcpy( p, &u, 4 );
+#else
+    *reinterpret_cast<uint32*>(p) = x;
+#endif
+}
 
-    u.i = x;
 
-    p[3] = u.c[0];
-    p[2] = u.c[1];
-    p[1] = u.c[2];
-    p[0] = u.c[3];
+// writes count consecutive 32 bit values in network byte order
+static void FromUInt32Array( char *p, const void *values, unsigned long count )
+{
+#ifdef OSC_HOST_LITTLE_ENDIAN
+    const char *v = static_cast<const char*>(values);
+    for( unsigned long i=0; i < count; ++i ){
+        uint32 u;
+        memcpy( &u, v + i*4, 4 );
+        u = SwapBytes32( u );
+        memcpy( p + i*4, &u, 4 );
+    }
 #else
-    *reinterpret_cast<uint32*>(p) = x;
+    memcpy( p, values, count * 4 );
 #endif
 }
 
@@ -229,11 +240,11 @@ void OutboundPacketStream::CheckForAvailableMessageSpace( const char *addressPat
 }
 
 
-void OutboundPacketStream::CheckForAvailableArgumentSpace( long argumentLength )
+void OutboundPacketStream::CheckForAvailableArgumentSpace( long argumentLength, long argumentCount )
 {
-    // plus three for extra type tag, comma and null terminator
+    // plus two for comma and null terminator
      unsigned long required = (argumentCurrent_ - data_) + argumentLength
-            + RoundUp4( (end_ - typeTagsCurrent_) + 3 );
+            + RoundUp4( (end_ - typeTagsCurrent_) + argumentCount + 2 );
 
     if( required > Capacity() )
         throw OutOfBufferMemoryException();
@@ -409,6 +420,29 @@ OutboundPacketStream& OutboundPacketStream::operator<<( const MessageTerminator&
 }
 
 
+char *OutboundPacketStream::ReserveMessage( unsigned long size )
+{
+    if( IsMessageInProgress() )
+        throw MessageInProgressException();
+
+    unsigned long required = Size() + ((ElementSizeSlotRequired())?4:0) + size;
+
+    if( required > Capacity() )
+        throw OutOfBufferMemoryException();
+
+    if( ElementSizeSlotRequired() ){
+        FromUInt32( messageCursor_, size );
+        messageCursor_ += 4;
+    }
+
+    char *result = messageCursor_;
+    messageCursor_ += size;
+    argumentCurrent_ = messageCursor_;
+
+    return result;
+}
+
+
 OutboundPacketStream& OutboundPacketStream::operator<<( bool rhs )
 {
     CheckForAvailableArgumentSpace(0);
@@ -458,23 +492,7 @@ OutboundPacketStream& OutboundPacketStream::operator<<( float rhs )
     CheckForAvailableArgumentSpace(4);
 
     *(--typeTagsCurrent_) = FLOAT_TYPE_TAG;
-
-#ifdef OSC_HOST_LITTLE_ENDIAN
-    union{
-        float f;
-        char c[4];
-    } u;
-
-    u.f = rhs;
-
-    argumentCurrent_[3] = u.c[0];
-    argumentCurrent_[2] = u.c[1];
-    argumentCurrent_[1] = u.c[2];
-    argumentCurrent_[0] = u.c[3];
-#else
-    *reinterpret_cast<float*>(argumentCurrent_) = rhs;
-#endif
-
+    FromUInt32Array( argumentCurrent_, &rhs, 1 );
     argumentCurrent_ += 4;
 
     return *this;
@@ -634,6 +652,60 @@ OutboundPacketStream& OutboundPacketStream::operator<<( const Blob& rhs )
     return *this;
 }
 
+
+OutboundPacketStream& OutboundPacketStream::operator<<( const Int32Array& rhs )
+{
+    if( rhs.count == 0 )
+        return *this;
+
+    CheckForAvailableArgumentSpace( rhs.count * 4, rhs.count );
+
+    // the type tags are stored in reverse order, which makes no difference for a run of equal ones
+    typeTagsCurrent_ -= rhs.count;
+    memset( typeTagsCurrent_, INT32_TYPE_TAG, rhs.count );
+    FromUInt32Array( argumentCurrent_, rhs.values, rhs.count );
+    argumentCurrent_ += rhs.count * 4;
+
+    return *this;
+}
+
+
+OutboundPacketStream& OutboundPacketStream::operator<<( const FloatArray& rhs )
+{
+    if( rhs.count == 0 )
+        return *this;
+
+    CheckForAvailableArgumentSpace( rhs.count * 4, rhs.count );
+
+    typeTagsCurrent_ -= rhs.count;
+    memset( typeTagsCurrent_, FLOAT_TYPE_TAG, rhs.count );
+    FromUInt32Array( argumentCurrent_, rhs.values, rhs.count );
+    argumentCurrent_ += rhs.count * 4;
+
+    return *this;
+}
+
+
+OutboundPacketStream& OutboundPacketStream::operator<<( const Fields& rhs )
+{
+    unsigned long count = strlen( rhs.typeTags );
+    if( count == 0 )
+        return *this;
+
+    CheckForAvailableArgumentSpace( count * 4, count );
+
+    for( unsigned long i=0; i < count; ++i ){
+        assert( rhs.typeTags[i] == INT32_TYPE_TAG || rhs.typeTags[i] == FLOAT_TYPE_TAG
+                || rhs.typeTags[i] == CHAR_TYPE_TAG || rhs.typeTags[i] == RGBA_COLOR_TYPE_TAG
+                || rhs.typeTags[i] == MIDI_MESSAGE_TYPE_TAG );
+        *(--typeTagsCurrent_) = rhs.typeTags[i];
+    }
+    FromUInt32Array( argumentCurrent_, rhs.data, count );
+    argumentCurrent_ += count * 4;
+
+    return *this;
+}
+
 } // namespace osc
 
 
@@ -111,6 +111,15 @@ public:
     OutboundPacketStream& operator<<( const char* rhs );
     OutboundPacketStream& operator<<( const Symbol& rhs );
     OutboundPacketStream& operator<<( const Blob& rhs );
+    OutboundPacketStream& operator<<( const Int32Array& rhs );
+    OutboundPacketStream& operator<<( const FloatArray& rhs );
+    OutboundPacketStream& operator<<( const Fields& rhs );
+
+    // reserves space for a complete, preformatted message of the given size
+    // (a multiple of 4) and returns a pointer to the reserved space. within
+    // a bundle the element size slot is written, the caller is responsible
+    // for filling in the address, type tags and arguments.
+    char *ReserveMessage( unsigned long size );
 
 private:
 
@@ -120,7 +129,7 @@ private:
     bool ElementSizeSlotRequired() const;
     void CheckForAvailableBundleSpace();
     void CheckForAvailableMessageSpace( const char *addressPattern );
-    void CheckForAvailableArgumentSpace( long argumentLength );
+    void CheckForAvailableArgumentSpace( long argumentLength, long argumentCount=1 );
 
     char *data_;
     char *end_;
@@ -30,6 +30,7 @@
 #include "OscReceivedElements.h"
 
 #include <cassert>
+#include <cstring>
 
 #include "OscHostEndianness.h"
 
@@ -524,6 +525,14 @@ ReceivedMessage::ReceivedMessage( const ReceivedBundleElement& bundleElement )
 }
 
 
+bool ReceivedMessage::HasTypeTags( const char *typeTags ) const
+{
+    if( typeTagsBegin_ == 0 )
+        return (typeTags[0] == '\0');
+    return (std::strcmp( typeTagsBegin_, typeTags ) == 0);
+}
+
+
 bool ReceivedMessage::AddressPatternIsUInt32() const
 {
 	return (addressPattern_[0] == '\0');
@@ -597,22 +606,18 @@ void ReceivedMessage::Init( const char *message, unsigned long size )
                     case RGBA_COLOR_TYPE_TAG:
                     case MIDI_MESSAGE_TYPE_TAG:
 
-                        if( argument == end )
+                        if( end - argument < 4 )
                             throw MalformedMessageException( "arguments exceed message size" );
                         argument += 4;
-                        if( argument > end )
-                            throw MalformedMessageException( "arguments exceed message size" );
                         break;
 
                     case INT64_TYPE_TAG:
                     case TIME_TAG_TYPE_TAG:
                     case DOUBLE_TYPE_TAG:
 
-                        if( argument == end )
+                        if( end - argument < 8 )
                             throw MalformedMessageException( "arguments exceed message size" );
                         argument += 8;
-                        if( argument > end )
-                            throw MalformedMessageException( "arguments exceed message size" );
                         break;
 
                     case STRING_TYPE_TAG: 
@@ -627,13 +632,17 @@ void ReceivedMessage::Init( const char *message, unsigned long size )
 
                     case BLOB_TYPE_TAG:
                         {
-                            if( argument + 4 > end )
-                                MalformedMessageException( "arguments exceed message size" );
+                            if( end - argument < 4 )
+                                throw MalformedMessageException( "arguments exceed message size" );
                                 
+                            // compare the sizes before advancing, so huge blob sizes can not wrap around
                             uint32 blobSize = ToUInt32( argument );
-                            argument = argument + 4 + RoundUp4( blobSize );
+                            argument += 4;
+                            if( blobSize > (unsigned long)(end - argument) )
+                                throw MalformedMessageException( "arguments exceed message size" );
+                            argument += RoundUp4( blobSize );
                             if( argument > end )
-                                MalformedMessageException( "arguments exceed message size" );
+                                throw MalformedMessageException( "arguments exceed message size" );
                         }
                         break;
                         
@@ -700,9 +709,10 @@ void ReceivedBundle::Init( const char *bundle, unsigned long size )
         if( (elementSize & 0x03L) != 0 )
             throw MalformedBundleException( "bundle element size must be multiple of four" );
 
-        p += 4 + elementSize;
-        if( p > end_ )
+        p += 4;
+        if( elementSize > (unsigned long)(end_ - p) )
             throw MalformedBundleException( "packet too short for bundle element" );
+        p += elementSize;
 
         ++elementCount_;
     }
@@ -109,7 +109,7 @@ public:
 	ReceivedBundleElementIterator( const char *sizePtr )
         : value_( sizePtr ) {}
 
-	ReceivedBundleElementIterator operator++()
+	ReceivedBundleElementIterator& operator++()
 	{
         Advance();
         return *this;
@@ -230,7 +230,7 @@ public:
 	ReceivedMessageArgumentIterator( const char *typeTags, const char *arguments )
         : value_( typeTags, arguments ) {}
 
-	ReceivedMessageArgumentIterator operator++()
+	ReceivedMessageArgumentIterator& operator++()
 	{
         Advance();
         return *this;
@@ -425,6 +425,11 @@ public:
 
     const char *TypeTags() const { return typeTagsBegin_; }
 
+    // returns true if the type tags (without the leading ',') equal the provided ones.
+    // all arguments have been validated during construction, so once the type tags
+    // are known the arguments may be read with the As*Unchecked() methods.
+    bool HasTypeTags( const char *typeTags ) const;
+
 
     typedef ReceivedMessageArgumentIterator const_iterator;
     
@@ -172,6 +172,40 @@ struct Blob{
     unsigned long size;
 };
 
+
+// arrays of int32 or float arguments. they are appended with a single
+// capacity check and their type tags and values are written in bulk.
+
+struct Int32Array{
+    Int32Array() {}
+    explicit Int32Array( const int32* values_, unsigned long count_ )
+            : values( values_ ), count( count_ ) {}
+    const int32* values;
+    unsigned long count;
+};
+
+
+struct FloatArray{
+    FloatArray() {}
+    explicit FloatArray( const float* values_, unsigned long count_ )
+            : values( values_ ), count( count_ ) {}
+    const float* values;
+    unsigned long count;
+};
+
+
+// a run of 32 bit arguments stored in consecutive fields, for example of a
+// struct. typeTags holds the type tag of each field, which has to be one of
+// the 32 bit types i, f, c, r or m.
+
+struct Fields{
+    Fields() {}
+    explicit Fields( const char* typeTags_, const void* data_ )
+            : typeTags( typeTags_ ), data( data_ ) {}
+    const char* typeTags;
+    const void* data;
+};
+
 } // namespace osc
 
 
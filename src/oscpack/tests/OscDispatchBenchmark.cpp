@@ -0,0 +1,227 @@
+/*
+	oscpack -- Open Sound Control packet manipulation library
+	http://www.audiomulch.com/~rossb/oscpack
+
+	Copyright (c) 2004-2005 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+    Dispatch benchmark for MessageMappingOscPacketListener with TUIO traffic.
+
+    The messages of a TUIO 2Dcur bundle (alive, 22 set messages and fseq) are
+    parsed once and then dispatched repeatedly through ProcessMessage() of
+
+        map:   the former std::map<const char*, ...> lookup with strcmp,
+               which is reproduced below as MapOscPacketListener, and
+        trie:  the osc::AddressTrie based MessageMappingOscPacketListener,
+
+    with 3, 4, 8 and 16 registered TUIO profile addresses. The trie is also
+    measured with the wildcard pattern /tuio/2D{cur,obj}, which the map can
+    not dispatch. The best of 7 alternating runs is reported in nanoseconds
+    per message.
+
+        g++ -O2 -I.. OscDispatchBenchmark.cpp ../osc/OscAddressTrie.cpp
+            ../osc/OscReceivedElements.cpp ../osc/OscOutboundPacketStream.cpp
+            ../osc/OscTypes.cpp
+        ./a.out [iterations]
+*/
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <vector>
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/MessageMappingOscPacketListener.h"
+#include "ip/IpEndpointName.h"
+
+
+namespace osc{
+
+// the std::map based dispatch MessageMappingOscPacketListener used before
+template< class T >
+class MapOscPacketListener : public OscPacketListener{
+public:
+    typedef void (T::*function_type)(const osc::ReceivedMessage&, const IpEndpointName&);
+
+protected:
+    void RegisterMessageFunction( const char *addressPattern, function_type f )
+    {
+        functions_.insert( std::make_pair( addressPattern, f ) );
+    }
+
+    virtual void ProcessMessage( const osc::ReceivedMessage& m,
+		const IpEndpointName& remoteEndpoint )
+    {
+        typename function_map_type::iterator i = functions_.find( m.AddressPattern() );
+        if( i != functions_.end() )
+            (dynamic_cast<T*>(this)->*(i->second))( m, remoteEndpoint );
+    }
+    
+private:
+    struct cstr_compare{
+        bool operator()( const char *lhs, const char *rhs ) const
+            { return std::strcmp( lhs, rhs ) < 0; }
+    };
+
+    typedef std::map<const char*, function_type, cstr_compare> function_map_type;
+    function_map_type functions_;
+};
+
+} // namespace osc
+
+
+using namespace osc;
+
+static const int CURSORS = 22;
+static const int RUNS = 7;
+
+static const char *addresses_[] = {
+    "/tuio/2Dobj", "/tuio/2Dcur", "/tuio/2Dblb", "/tuio/25Dobj",
+    "/tuio/25Dcur", "/tuio/25Dblb", "/tuio/3Dobj", "/tuio/3Dcur",
+    "/tuio/3Dblb", "/tuio/_sxyXYm", "/tuio/_ixyP", "/tuio/_sxyP",
+    "/tuio2/frm", "/tuio2/tok", "/tuio2/ptr", "/tuio2/alv" };
+
+
+template< template< class > class Listener >
+class Receiver : public Listener< Receiver< Listener > >{
+public:
+    unsigned long received;
+
+    Receiver( int addressCount )
+        : received( 0 )
+    {
+        for( int i = 0; i < addressCount; ++i )
+            this->RegisterMessageFunction( addresses_[i], &Receiver::Count );
+    }
+
+    void Dispatch( const std::vector<ReceivedMessage>& messages, long iterations )
+    {
+        IpEndpointName endpoint;
+        for( long i = 0; i < iterations; ++i )
+            for( std::size_t j = 0; j < messages.size(); ++j )
+                this->ProcessMessage( messages[j], endpoint );
+    }
+
+private:
+    void Count( const ReceivedMessage&, const IpEndpointName& )
+    {
+        ++received;
+    }
+};
+
+
+static unsigned long TuioFrame( char *buffer, unsigned long capacity, const char *address )
+{
+    OutboundPacketStream p( buffer, capacity );
+    p << BeginBundleImmediate
+        << BeginMessage( address ) << "alive";
+    for( int i = 0; i < CURSORS; ++i )
+        p << (int32)i;
+    p << EndMessage;
+
+    for( int i = 0; i < CURSORS; ++i )
+        p << BeginMessage( address ) << "set" << (int32)i
+            << i * .01f << .5f << .1f << .2f << .3f << EndMessage;
+
+    p << BeginMessage( address ) << "fseq" << (int32)1 << EndMessage
+        << EndBundle;
+
+    return p.Size();
+}
+
+
+static void Parse( const char *packet, unsigned long size, std::vector<ReceivedMessage>& messages )
+{
+    ReceivedBundle b( ReceivedPacket( packet, (int32)size ) );
+    for( ReceivedBundle::const_iterator e = b.ElementsBegin(); e != b.ElementsEnd(); ++e )
+        messages.push_back( ReceivedMessage( *e ) );
+}
+
+
+template< class R >
+static double NanosecondsPerMessage( R& receiver,
+        const std::vector<ReceivedMessage>& messages, long iterations )
+{
+    unsigned long before = receiver.received;
+    std::clock_t start = std::clock();
+    receiver.Dispatch( messages, iterations );
+    double seconds = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+
+    if( receiver.received - before != messages.size() * iterations ){
+        std::printf( "%lu of %lu messages dispatched\n",
+                receiver.received - before, (unsigned long)(messages.size() * iterations) );
+        std::exit( 1 );
+    }
+    return seconds * 1e9 / (messages.size() * iterations);
+}
+
+
+int main( int argc, char* argv[] )
+{
+    long iterations = (argc > 1) ? std::atol( argv[1] ) : 100000;
+
+    char literal[4096], pattern[4096];
+    std::vector<ReceivedMessage> literalMessages, patternMessages;
+    Parse( literal, TuioFrame( literal, sizeof(literal), "/tuio/2Dcur" ), literalMessages );
+    Parse( pattern, TuioFrame( pattern, sizeof(pattern), "/tuio/2D{cur,obj}" ), patternMessages );
+
+    std::printf( "%d messages per frame, best of %d runs, ns per message\n",
+            (int)literalMessages.size(), RUNS );
+    std::printf( "addresses    map   trie  trie /tuio/2D{cur,obj}\n" );
+
+    const int counts[] = { 3, 4, 8, 16 };
+    for( int c = 0; c < 4; ++c ){
+        Receiver<MapOscPacketListener> map( counts[c] );
+        Receiver<MessageMappingOscPacketListener> trie( counts[c] );
+
+        // the pattern matches two addresses, so its rate is per dispatched message
+        double mapBest = 1e9, trieBest = 1e9, patternBest = 1e9;
+        for( int run = 0; run < RUNS; ++run ){
+            double ns = NanosecondsPerMessage( map, literalMessages, iterations );
+            if( ns < mapBest )
+                mapBest = ns;
+            ns = NanosecondsPerMessage( trie, literalMessages, iterations );
+            if( ns < trieBest )
+                trieBest = ns;
+        }
+
+        Receiver<MessageMappingOscPacketListener> wildcard( counts[c] );
+        for( int run = 0; run < RUNS; ++run ){
+            unsigned long before = wildcard.received;
+            std::clock_t start = std::clock();
+            wildcard.Dispatch( patternMessages, iterations / 10 );
+            double seconds = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+            double ns = seconds * 1e9 / (wildcard.received - before);
+            if( ns < patternBest )
+                patternBest = ns;
+        }
+
+        std::printf( "%9d  %5.1f  %5.1f  %5.1f\n", counts[c], mapBest, trieBest, patternBest );
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+	oscpack -- Open Sound Control packet manipulation library
+	http://www.audiomulch.com/~rossb/oscpack
+
+	Copyright (c) 2004-2005 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+    Fuzz target for the packet validation in OscReceivedElements.cpp.
+
+    Every input is parsed as a packet, all bundle elements are visited
+    recursively and every message argument is read with the As*Unchecked()
+    methods after checking its type tag, just like a receiver which trusts
+    the validation done during construction. Malformed input must only ever
+    raise an osc::Exception.
+
+    With libFuzzer:
+        clang++ -g -fsanitize=fuzzer,address,undefined -DOSC_FUZZING_ENGINE
+            -I.. OscReceiveFuzz.cpp ../osc/OscReceivedElements.cpp
+            ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+
+    Standalone, mutating a TUIO frame or replaying the given input files:
+        g++ -g -fsanitize=address,undefined -I.. OscReceiveFuzz.cpp
+            ../osc/OscReceivedElements.cpp ../osc/OscOutboundPacketStream.cpp ../osc/OscTypes.cpp
+        ./a.out [-n iterations] [file ...]
+*/
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include "osc/OscReceivedElements.h"
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscException.h"
+
+
+namespace osc{
+
+static unsigned long checksum_ = 0;
+
+static void ReadArguments( const ReceivedMessage& m )
+{
+    // touch the signatures the TUIO client compares against
+    if( m.HasTypeTags( "sifffff" ) || m.HasTypeTags( "siifffffffff" ) )
+        ++checksum_;
+
+    for( ReceivedMessageArgumentIterator i = m.ArgumentsBegin();
+            i != m.ArgumentsEnd(); ++i ){
+
+        switch( i->TypeTag() ){
+            case TRUE_TYPE_TAG:
+            case FALSE_TYPE_TAG:
+                checksum_ += i->AsBoolUnchecked();
+                break;
+            case NIL_TYPE_TAG:
+            case INFINITUM_TYPE_TAG:
+                break;
+            case INT32_TYPE_TAG:
+                checksum_ += i->AsInt32Unchecked();
+                break;
+            case FLOAT_TYPE_TAG:
+                checksum_ += (unsigned long)(i->AsFloatUnchecked() != 0.f);
+                break;
+            case CHAR_TYPE_TAG:
+                checksum_ += i->AsCharUnchecked();
+                break;
+            case RGBA_COLOR_TYPE_TAG:
+                checksum_ += i->AsRgbaColorUnchecked();
+                break;
+            case MIDI_MESSAGE_TYPE_TAG:
+                checksum_ += i->AsMidiMessageUnchecked();
+                break;
+            case INT64_TYPE_TAG:
+                checksum_ += (unsigned long)i->AsInt64Unchecked();
+                break;
+            case TIME_TAG_TYPE_TAG:
+                checksum_ += (unsigned long)i->AsTimeTagUnchecked();
+                break;
+            case DOUBLE_TYPE_TAG:
+                checksum_ += (unsigned long)(i->AsDoubleUnchecked() != 0.);
+                break;
+            case STRING_TYPE_TAG:
+                checksum_ += std::strlen( i->AsStringUnchecked() );
+                break;
+            case SYMBOL_TYPE_TAG:
+                checksum_ += std::strlen( i->AsSymbolUnchecked() );
+                break;
+            case BLOB_TYPE_TAG:
+                {
+                    const void *data;
+                    unsigned long size;
+                    i->AsBlobUnchecked( data, size );
+                    for( unsigned long j = 0; j < size; ++j )
+                        checksum_ += ((const unsigned char*)data)[j];
+                }
+                break;
+            default:
+                throw MalformedMessageException( "unknown type tag passed validation" );
+        }
+    }
+}
+
+
+static void ReadBundle( const ReceivedBundle& b )
+{
+    checksum_ += (unsigned long)b.TimeTag();
+
+    for( ReceivedBundleElementIterator i = b.ElementsBegin();
+            i != b.ElementsEnd(); ++i ){
+        if( i->IsBundle() )
+            ReadBundle( ReceivedBundle( *i ) );
+        else
+            ReadArguments( ReceivedMessage( *i ) );
+    }
+}
+
+
+static void ReadPacket( const char *data, unsigned long size )
+{
+    try{
+        ReceivedPacket p( data, (int32)size );
+        if( p.IsBundle() )
+            ReadBundle( ReceivedBundle( p ) );
+        else
+            ReadArguments( ReceivedMessage( p ) );
+    }catch( Exception& ){
+        // malformed packets are expected and simply dropped
+    }
+}
+
+} // namespace osc
+
+
+extern "C" int LLVMFuzzerTestOneInput( const unsigned char *data, size_t size )
+{
+    osc::ReadPacket( (const char*)data, (unsigned long)size );
+    return 0;
+}
+
+
+#ifndef OSC_FUZZING_ENGINE
+
+static unsigned long random_ = 1;
+
+static unsigned long Random( unsigned long range )
+{
+    random_ = random_ * 1103515245UL + 12345UL;
+    return ((random_ >> 16) & 0x7fff) % range;
+}
+
+
+static unsigned long Seed( char *buffer, unsigned long capacity )
+{
+    using namespace osc;
+
+    char blob[] = { 1, 2, 3, 4, 5 };
+
+    OutboundPacketStream p( buffer, capacity );
+    p << BeginBundleImmediate
+        << BeginMessage( "/tuio/2Dcur" ) << "source" << "fuzz" << EndMessage
+        << BeginMessage( "/tuio/2Dcur" ) << "alive" << (int32)1 << (int32)2 << EndMessage
+        << BeginMessage( "/tuio/2Dcur" ) << "set" << (int32)1
+            << .1f << .2f << 0.f << 0.f << 0.f << EndMessage
+        << BeginMessage( "/tuio/2Dobj" ) << "set" << (int32)3 << (int32)4
+            << .1f << .2f << .3f << 0.f << 0.f << 0.f << 0.f << 0.f << EndMessage
+        << BeginBundle( 1234 )
+            << BeginMessage( "/fuzz" ) << true << false << NilType() << Infinitum
+                << 'c' << RgbaColor( 0x11223344 ) << MidiMessage( 0x55667788 )
+                << (int64)-5 << TimeTag( 99 ) << 2.5 << Symbol( "sym" )
+                << Blob( blob, sizeof(blob) ) << EndMessage
+        << EndBundle
+        << BeginMessage( "/tuio/2Dcur" ) << "fseq" << (int32)7 << EndMessage
+        << EndBundle;
+
+    return p.Size();
+}
+
+
+static int ReplayFile( const char *path )
+{
+    FILE *f = std::fopen( path, "rb" );
+    if( !f ){
+        std::fprintf( stderr, "can not open %s\n", path );
+        return 1;
+    }
+
+    char *data = 0;
+    unsigned long size = 0, capacity = 0;
+    for(;;){
+        if( size == capacity ){
+            capacity = capacity ? capacity * 2 : 4096;
+            data = (char*)std::realloc( data, capacity );
+        }
+        unsigned long n = std::fread( data + size, 1, capacity - size, f );
+        if( n == 0 )
+            break;
+        size += n;
+    }
+    std::fclose( f );
+
+    // copy to an exactly sized buffer so overreads are detected by the sanitizers
+    char *exact = (char*)std::malloc( size ? size : 1 );
+    std::memcpy( exact, data, size );
+    LLVMFuzzerTestOneInput( (const unsigned char*)exact, size );
+    std::free( exact );
+    std::free( data );
+    return 0;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    long iterations = 1000000;
+    int files = 0, result = 0;
+
+    for( int i = 1; i < argc; ++i ){
+        if( std::strcmp( argv[i], "-n" ) == 0 && i + 1 < argc )
+            iterations = std::atol( argv[++i] );
+        else{
+            result |= ReplayFile( argv[i] );
+            ++files;
+        }
+    }
+
+    if( files > 0 ){
+        std::printf( "replayed %d files\n", files );
+        return result;
+    }
+
+    char seed[1024];
+    unsigned long seedSize = Seed( seed, sizeof(seed) );
+
+    for( long i = 0; i < iterations; ++i ){
+        unsigned long size = seedSize;
+        if( Random( 8 ) == 0 )
+            size = Random( seedSize / 4 + 1 ) * 4;
+        else if( Random( 8 ) == 0 )
+            size = Random( seedSize + 1 );
+
+        char *packet = (char*)std::malloc( size ? size : 1 );
+        std::memcpy( packet, seed, size );
+
+        if( size > 0 ){
+            unsigned long mutations = 1 + Random( 4 );
+            for( unsigned long j = 0; j < mutations; ++j ){
+                unsigned long pos = Random( size );
+                switch( Random( 4 ) ){
+                    case 0: packet[pos] = (char)Random( 256 ); break;
+                    case 1: packet[pos] = (char)0xFF; break;
+                    case 2: packet[pos] = 0; break;
+                    default: packet[pos] ^= (char)(1 << Random( 8 )); break;
+                }
+            }
+        }
+
+        LLVMFuzzerTestOneInput( (const unsigned char*)packet, size );
+        std::free( packet );
+    }
+
+    std::printf( "parsed %ld mutated packets (checksum %lu)\n", iterations, osc::checksum_ );
+    return 0;
+}
+
+#endif /* OSC_FUZZING_ENGINE */